@@ -0,0 +1,116 @@
+//
+//  arena_allocator.hpp
+//  linked_list
+//
+//  Monotonic arena allocator for List<T, Alloc>. Nodes are bump-allocated
+//  from a std::pmr::monotonic_buffer_resource and never freed one by one;
+//  the memory goes back when the resource is released or destroyed. For
+//  trivially destructible T, clear() and ~List() do no per-node work.
+//
+
+#ifndef arena_allocator_hpp
+#define arena_allocator_hpp
+
+#include <memory_resource>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#include "list.hpp"
+
+
+/*************************************************************************/
+/*                                                                       */
+/* ********************************************************************* */
+/* **************************** Declaration **************************** */
+/* ********************************************************************* */
+/*                                                                       */
+/*************************************************************************/
+
+
+template<typename T>
+class ArenaAllocator {
+    
+    template<typename> friend class ArenaAllocator;
+    
+    std::pmr::monotonic_buffer_resource * resource;
+    
+public:
+    
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+    
+    ArenaAllocator(std::pmr::monotonic_buffer_resource & arena);
+    
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> & other);
+    
+    /* Throws std::bad_array_new_length if n > max_size() */
+    
+    T * allocate(const size_t n);
+    void deallocate(T * ptr, const size_t n) noexcept;
+    size_t max_size() const noexcept;
+    
+    std::pmr::monotonic_buffer_resource * arena() const;
+    
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> & other) const;
+    
+};
+
+template<typename T>
+struct allocator_releases_in_bulk<ArenaAllocator<T>> : std::true_type { };
+
+template<typename T>
+using ArenaList = List<T, ArenaAllocator<T>>;
+
+/**************************************************************************/
+/*                                                                        */
+/* ********************************************************************** */
+/* *************************** Implementation *************************** */
+/* ********************************************************************** */
+/*                                                                        */
+/**************************************************************************/
+
+
+template<typename T>
+ArenaAllocator<T>::ArenaAllocator(std::pmr::monotonic_buffer_resource & arena)
+    : resource(&arena) { }
+
+template<typename T>
+template<typename U>
+ArenaAllocator<T>::ArenaAllocator(const ArenaAllocator<U> & other)
+    : resource(other.resource) { }
+
+template<typename T>
+T * ArenaAllocator<T>::allocate(const size_t n) {
+    if (n > max_size()) {
+        throw std::bad_array_new_length();
+    }
+    return static_cast<T *>(resource->allocate(n * sizeof(T), alignof(T)));
+}
+
+template<typename T>
+void ArenaAllocator<T>::deallocate(T *, const size_t) noexcept { }
+
+template<typename T>
+size_t ArenaAllocator<T>::max_size() const noexcept {
+    return std::numeric_limits<size_t>::max() / sizeof(T);
+}
+
+template<typename T>
+std::pmr::monotonic_buffer_resource * ArenaAllocator<T>::arena() const {
+    return resource;
+}
+
+template<typename T>
+template<typename U>
+bool ArenaAllocator<T>::operator==(const ArenaAllocator<U> & other) const {
+    return resource == other.resource;
+}
+
+#endif /* arena_allocator_hpp */
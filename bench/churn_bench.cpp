@@ -0,0 +1,110 @@
+//
+//  churn_bench.cpp
+//  linked_list
+//
+//  Push/pop churn with the default allocator vs. the pooled node allocator.
+//
+//  Build: g++ -std=c++20 -O2 -I.. churn_bench.cpp -o churn_bench
+//
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+#include "list.hpp"
+#include "pool_allocator.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+struct Payload {
+    long long values[8];
+    explicit Payload(const long long v) : values{v} { }
+};
+
+template<typename Fun>
+double measure(Fun fun) {
+    
+    const auto start = Clock::now();
+    fun();
+    const auto end = Clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+    
+}
+
+/* Fill the list to size, drain it completely, repeat */
+template<typename L>
+double fillDrain(const size_t size, const size_t rounds) {
+    
+    L list;
+    volatile size_t sink = 0;
+    
+    return measure([&]() {
+        for (size_t r = 0; r < rounds; ++r) {
+            for (size_t i = 0; i < size; ++i) {
+                list.push_back(typename L::value_type(i));
+            }
+            while (list.size()) {
+                list.pop_front();
+            }
+            sink = sink + list.size();
+        }
+    });
+    
+}
+
+/* Keep size elements queued, push_back/pop_front ops times */
+template<typename L>
+double steadyQueue(const size_t size, const size_t ops) {
+    
+    L list;
+    for (size_t i = 0; i < size; ++i) {
+        list.push_back(typename L::value_type(i));
+    }
+    volatile size_t sink = 0;
+    
+    return measure([&]() {
+        for (size_t i = 0; i < ops; ++i) {
+            list.push_back(typename L::value_type(i));
+            list.pop_front();
+        }
+        sink = sink + list.size();
+    });
+    
+}
+
+template<typename T>
+void run(const std::string & name) {
+    
+    const size_t ops = 4000000;
+    
+    for (size_t size = 1000; size <= 1000000; size *= 10) {
+        
+        const size_t rounds = ops / size;
+        
+        std::cout << std::setw(10) << name
+                  << std::setw(10) << size
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(14) << fillDrain<List<T>>(size, rounds)
+                  << std::setw(14) << fillDrain<PooledList<T>>(size, rounds)
+                  << std::setw(14) << steadyQueue<List<T>>(size, ops)
+                  << std::setw(14) << steadyQueue<PooledList<T>>(size, ops)
+                  << std::endl;
+        
+    }
+    
+}
+
+int main() {
+    
+    std::cout << std::setw(10) << "payload"
+              << std::setw(10) << "size"
+              << std::setw(14) << "fill/drain"
+              << std::setw(14) << "pooled"
+              << std::setw(14) << "queue"
+              << std::setw(14) << "pooled" << std::endl;
+    
+    run<int>("int");
+    run<Payload>("64 bytes");
+    
+}
@@ -0,0 +1,101 @@
+//
+//  io_bench.cpp
+//  linked_list
+//
+//  Loading a list from disk: parsing text and pushing item by item vs.
+//  read_binary() into List and into ArenaList, where all nodes come from
+//  one allocation, vs. opening the file as a MappedList and summing it.
+//
+//  Build: g++ -std=c++20 -O2 -I.. io_bench.cpp -o io_bench
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <numeric>
+#include <string>
+
+#include <unistd.h>
+
+#include "list.hpp"
+#include "list_io.hpp"
+#include "arena_allocator.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+template<typename Fun>
+double measure(Fun fun) {
+    
+    const auto start = Clock::now();
+    fun();
+    const auto end = Clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+    
+}
+
+void report(const std::string & name, const double ms) {
+    std::cout << std::setw(16) << name
+              << std::fixed << std::setprecision(3)
+              << std::setw(12) << ms << std::endl;
+}
+
+int main(int argc, const char * argv[]) {
+    
+    const size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    const std::string pid = std::to_string(getpid());
+    const std::filesystem::path text = dir / ("io_bench_" + pid + ".txt");
+    const std::filesystem::path binary = dir / ("io_bench_" + pid + ".bin");
+    
+    {
+        List<long> list;
+        for (size_t i = 0; i < size; ++i) {
+            list.push_back(long(i * 7919 % 1000003));
+        }
+        std::ofstream textOut(text);
+        for (const long item : list) {
+            textOut << item << '\n';
+        }
+        std::ofstream binaryOut(binary, std::ios::binary);
+        write_binary(list, binaryOut);
+    }
+    
+    volatile long sink = 0;
+    std::cout << size << " longs, ms" << std::endl;
+    
+    report("text + push", measure([&]() {
+        std::ifstream in(text);
+        List<long> list;
+        for (long item; in >> item; ) {
+            list.push_back(item);
+        }
+        sink = sink + long(list.size());
+    }));
+    
+    report("read_binary", measure([&]() {
+        std::ifstream in(binary, std::ios::binary);
+        const List<long> list = read_binary<long>(in);
+        sink = sink + long(list.size());
+    }));
+    
+    report("arena binary", measure([&]() {
+        std::pmr::monotonic_buffer_resource arena;
+        std::ifstream in(binary, std::ios::binary);
+        const ArenaList<long> list = read_binary<long>(in, ArenaAllocator<long>(arena));
+        sink = sink + long(list.size());
+    }));
+    
+    report("mmap + sum", measure([&]() {
+        const MappedList<long> list(binary.string());
+        sink = sink + std::accumulate(list.begin(), list.end(), 0L);
+    }));
+    
+    std::filesystem::remove(text);
+    std::filesystem::remove(binary);
+    
+}
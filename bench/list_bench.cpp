@@ -0,0 +1,568 @@
+//
+//  list_bench.cpp
+//  linked_list
+//
+//  Benchmark suite for List<T>, with std::forward_list, std::list and
+//  std::vector as baselines. Every operation runs for int, a 64 byte POD
+//  and std::string payloads at sizes 10 to 10^7, results are written as
+//  JSON in the layout of Google Benchmark so the usual compare tools work.
+//
+//  Build: cmake --build <build dir> --target list_bench
+//  Usage: ./list_bench [--max-size N] [--filter SUBSTRING] [--out FILE]
+//         JSON goes to stdout unless --out is given, progress to stderr
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <forward_list>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "list.hpp"
+#include "pool_allocator.hpp"
+#include "list_views.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+/* Repetitions stop after this much measured time, or this much wall */
+/* time including the untimed setup, whichever comes first           */
+const double minTimeNs = 50e6;
+const double maxWallNs = 1e9;
+const size_t maxReps = 1000;
+
+volatile size_t sink = 0;
+
+
+/********************************************************************/
+/*                                                                  */
+/*                             Payloads                             */
+/*                                                                  */
+/********************************************************************/
+
+struct Pod64 {
+    long long values[8];
+};
+
+static_assert(sizeof(Pod64) == 64);
+
+template<typename T>
+T make(const size_t i);
+
+template<>
+int make<int>(const size_t i) {
+    return static_cast<int>(i);
+}
+
+template<>
+Pod64 make<Pod64>(const size_t i) {
+    return Pod64 { { (long long)i } };
+}
+
+/* Long enough to defeat the small string optimization */
+template<>
+std::string make<std::string>(const size_t i) {
+    std::string s(32, 'a' + i % 26);
+    s[0] = '0' + i % 10;
+    return s;
+}
+
+size_t key(const int i) {
+    return i;
+}
+
+size_t key(const Pod64 & p) {
+    return p.values[0];
+}
+
+size_t key(const std::string & s) {
+    return s.size() + s[0];
+}
+
+
+/********************************************************************/
+/*                                                                  */
+/*                       Container operations                       */
+/*                                                                  */
+/********************************************************************/
+
+/* Each container is driven through the same set of free functions, */
+/* operations a container lacks are skipped in runContainer()        */
+
+template<typename C>
+constexpr bool isList = false;
+
+template<typename T, typename Alloc>
+constexpr bool isList<List<T, Alloc>> = true;
+
+template<typename C>
+constexpr bool isForwardList = false;
+
+template<typename T>
+constexpr bool isForwardList<std::forward_list<T>> = true;
+
+template<typename C>
+constexpr bool isVector = false;
+
+template<typename T>
+constexpr bool isVector<std::vector<T>> = true;
+
+template<typename C>
+C build(const size_t n) {
+    
+    C c;
+    if constexpr (isForwardList<C>) {
+        auto tail = c.before_begin();
+        for (size_t i = 0; i < n; ++i) {
+            tail = c.insert_after(tail, make<typename C::value_type>(i));
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            c.push_back(make<typename C::value_type>(i));
+        }
+    }
+    return c;
+    
+}
+
+template<typename C>
+size_t length(const C & c) {
+    if constexpr (isForwardList<C>) {
+        return std::distance(c.begin(), c.end());
+    } else {
+        return c.size();
+    }
+}
+
+template<typename C>
+void pushFront(C & c, typename C::value_type && item) {
+    if constexpr (isList<C>) {
+        c.push(std::move(item));
+    } else if constexpr (isVector<C>) {
+        c.insert(c.begin(), std::move(item));
+    } else {
+        c.push_front(std::move(item));
+    }
+}
+
+template<typename C>
+void insertAt(C & c, const size_t index, typename C::value_type && item) {
+    if constexpr (isList<C>) {
+        c.insert(index, std::move(item));
+    } else if constexpr (isForwardList<C>) {
+        c.insert_after(std::next(c.before_begin(), index), std::move(item));
+    } else {
+        c.insert(std::next(c.begin(), index), std::move(item));
+    }
+}
+
+template<typename C>
+size_t removeAt(C & c, const size_t index) {
+    if constexpr (isList<C>) {
+        return key(c.remove(index));
+    } else if constexpr (isForwardList<C>) {
+        auto prev = std::next(c.before_begin(), index);
+        const size_t k = key(*std::next(prev));
+        c.erase_after(prev);
+        return k;
+    } else {
+        auto it = std::next(c.begin(), index);
+        const size_t k = key(*it);
+        c.erase(it);
+        return k;
+    }
+}
+
+template<typename C>
+size_t popBack(C & c) {
+    if constexpr (isList<C>) {
+        return key(c.pop_back());
+    } else {
+        const size_t k = key(c.back());
+        c.pop_back();
+        return k;
+    }
+}
+
+template<typename C>
+size_t indexedSum(const C & c, const size_t n) {
+    size_t sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if constexpr (isList<C> or isVector<C>) {
+            sum += key(c[i]);
+        } else {
+            sum += key(*std::next(c.begin(), i));
+        }
+    }
+    return sum;
+}
+
+template<typename C>
+size_t iteratedSum(const C & c) {
+    size_t sum = 0;
+    for (const auto & item : c) {
+        sum += key(item);
+    }
+    return sum;
+}
+
+template<typename C>
+auto mapKeys(const C & c) {
+    if constexpr (isList<C>) {
+        return c.map([](const auto & item) { return key(item); });
+    } else if constexpr (isForwardList<C>) {
+        std::forward_list<size_t> out;
+        auto tail = out.before_begin();
+        for (const auto & item : c) {
+            tail = out.insert_after(tail, key(item));
+        }
+        return out;
+    } else {
+        using Out = std::conditional_t<isVector<C>,
+                                       std::vector<size_t>,
+                                       std::list<size_t>>;
+        Out out;
+        if constexpr (isVector<C>) {
+            out.reserve(c.size());
+        }
+        std::transform(c.begin(), c.end(), std::back_inserter(out),
+                       [](const auto & item) { return key(item); });
+        return out;
+    }
+}
+
+template<typename C>
+size_t foldKeys(const C & c) {
+    if constexpr (isList<C>) {
+        return c.fold([](size_t & acc, const auto & item) { acc += key(item); },
+                      size_t(0));
+    } else {
+        return std::accumulate(c.begin(), c.end(), size_t(0),
+                               [](size_t acc, const auto & item) {
+                                   return acc + key(item);
+                               });
+    }
+}
+
+template<typename C>
+C filterEven(const C & c) {
+    const auto even = [](const auto & item) { return key(item) % 2 == 0; };
+    if constexpr (isList<C>) {
+        return c.filter(even);
+    } else if constexpr (isForwardList<C>) {
+        C out;
+        auto tail = out.before_begin();
+        for (const auto & item : c) {
+            if (even(item)) {
+                tail = out.insert_after(tail, item);
+            }
+        }
+        return out;
+    } else {
+        C out;
+        std::copy_if(c.begin(), c.end(), std::back_inserter(out), even);
+        return out;
+    }
+}
+
+/* filter, map and fold chained, eagerly through the List members, which */
+/* build two intermediate lists, and lazily through list_views.hpp       */
+
+template<typename C>
+size_t chainEager(const C & c) {
+    return c.filter([](const auto & item) { return key(item) % 2 == 0; })
+            .map([](const auto & item) { return key(item); })
+            .fold([](size_t & acc, const size_t k) { acc += k; }, size_t(0));
+}
+
+template<typename C>
+size_t chainLazy(const C & c) {
+    return c | std::views::filter([](const auto & item) { return key(item) % 2 == 0; })
+             | std::views::transform([](const auto & item) { return key(item); })
+             | fold([](size_t & acc, const size_t k) { acc += k; }, size_t(0));
+}
+
+template<typename C>
+void appendCopy(C & c, const C & other) {
+    if constexpr (isList<C>) {
+        c.append(other);
+    } else if constexpr (isForwardList<C>) {
+        auto tail = c.before_begin();
+        for (auto it = c.begin(); it != c.end(); ++it) {
+            tail = it;
+        }
+        c.insert_after(tail, other.begin(), other.end());
+    } else {
+        c.insert(c.end(), other.begin(), other.end());
+    }
+}
+
+
+/********************************************************************/
+/*                                                                  */
+/*                             Harness                              */
+/*                                                                  */
+/********************************************************************/
+
+struct Result {
+    std::string name;
+    size_t iterations;
+    double nsPerOp;
+};
+
+struct Options {
+    size_t maxSize = 10000000;
+    std::string filter;
+    std::string out;
+};
+
+std::vector<Result> results;
+Options options;
+
+/* setup() builds the untimed state, op(state) is timed and performs */
+/* ops operations. Its return value is destroyed after the clock stops */
+template<typename Setup, typename Op>
+void measure(const std::string & name, const size_t ops, Setup setup, Op op) {
+    
+    if (name.find(options.filter) == std::string::npos) {
+        return;
+    }
+    
+    double total = 0;
+    size_t reps = 0;
+    const auto wallStart = Clock::now();
+    const auto wall = [&wallStart]() {
+        return std::chrono::duration<double, std::nano>(Clock::now() - wallStart).count();
+    };
+    
+    while (reps == 0 or
+           (total < minTimeNs and reps < maxReps and wall() < maxWallNs)) {
+        auto state = setup();
+        const auto start = Clock::now();
+        auto keep = op(state);
+        const auto end = Clock::now();
+        sink = sink + length(keep);
+        total += std::chrono::duration<double, std::nano>(end - start).count();
+        ++reps;
+    }
+    
+    results.push_back(Result { name, reps * ops, total / (reps * ops) });
+    std::cerr << std::left << std::setw(48) << name << std::right
+              << std::fixed << std::setprecision(2)
+              << std::setw(14) << results.back().nsPerOp << " ns/op" << std::endl;
+    
+}
+
+/* Caps the operation count of O(n) per operation benchmarks */
+size_t linearOps(const size_t n) {
+    return std::clamp<size_t>(10000000 / n, 1, n);
+}
+
+/* One element result, so measure() has something to count */
+std::vector<size_t> done(const size_t value) {
+    return std::vector<size_t>(1, value);
+}
+
+template<typename C>
+void runContainer(const std::string & container,
+                  const std::string & payload,
+                  const size_t n) {
+    
+    typedef typename C::value_type T;
+    const std::string suffix = "/" + container + "/" + payload + "/" + std::to_string(n);
+    const auto empty = []() { return C(); };
+    const auto full = [n]() { return build<C>(n); };
+    
+    /* Growth */
+    
+    /* forward_list appends through a tail iterator */
+    
+    measure("push_back" + suffix, n, empty, [n](C &) {
+        return build<C>(n);
+    });
+    
+    if (not isVector<C> or n <= 100000) {
+        measure("push" + suffix, n, empty, [n](C & c) {
+            for (size_t i = 0; i < n; ++i) {
+                pushFront(c, make<T>(i));
+            }
+            return done(length(c));
+        });
+    }
+    
+    const size_t ops = linearOps(n);
+    
+    measure("insert_middle" + suffix, ops, full, [n, ops](C & c) {
+        for (size_t i = 0; i < ops; ++i) {
+            insertAt(c, (n + i) / 2, make<T>(i));
+        }
+        return done(length(c));
+    });
+    
+    measure("remove_middle" + suffix, ops, full, [n, ops](C & c) {
+        size_t sum = 0;
+        for (size_t i = 0; i < ops; ++i) {
+            sum += removeAt(c, (n - i) / 2);
+        }
+        return done(sum);
+    });
+    
+    if constexpr (not isForwardList<C>) {
+        measure("pop_back" + suffix, ops, full, [ops](C & c) {
+            size_t sum = 0;
+            for (size_t i = 0; i < ops; ++i) {
+                sum += popBack(c);
+            }
+            return done(sum);
+        });
+    }
+    
+    /* Traversal, indexing a std list is quadratic and capped */
+    
+    if (isList<C> or isVector<C> or n <= 10000) {
+        measure("indexed_sum" + suffix, n, full, [n](C & c) {
+            return done(indexedSum(c, n));
+        });
+    }
+    
+    measure("iterated_sum" + suffix, n, full, [](C & c) {
+        return done(iteratedSum(c));
+    });
+    
+    /* Higher order functions */
+    
+    measure("map" + suffix, n, full, [](C & c) {
+        return mapKeys(c);
+    });
+    
+    measure("fold" + suffix, n, full, [](C & c) {
+        return done(foldKeys(c));
+    });
+    
+    measure("filter" + suffix, n, full, [](C & c) {
+        return filterEven(c);
+    });
+    
+    if constexpr (isList<C>) {
+        measure("chain_eager" + suffix, n, full, [](C & c) {
+            return done(chainEager(c));
+        });
+    }
+    
+    measure("chain_lazy" + suffix, n, full, [](C & c) {
+        return done(chainLazy(c));
+    });
+    
+    /* Copy and move */
+    
+    measure("copy" + suffix, n, full, [](C & c) {
+        return C(c);
+    });
+    
+    measure("move" + suffix, 1, full, [](C & c) {
+        return C(std::move(c));
+    });
+    
+    measure("append" + suffix, n, [n]() {
+        return std::make_pair(build<C>(n), build<C>(n));
+    }, [](std::pair<C, C> & p) {
+        appendCopy(p.first, p.second);
+        return done(length(p.first));
+    });
+    
+    /* Teardown */
+    
+    measure("clear" + suffix, n, full, [](C & c) {
+        c.clear();
+        return done(length(c));
+    });
+    
+}
+
+template<typename T>
+void runPayload(const std::string & payload) {
+    
+    for (size_t n = 10; n <= options.maxSize; n *= 10) {
+        runContainer<List<T>>("List", payload, n);
+        runContainer<PooledList<T>>("PooledList", payload, n);
+        runContainer<std::forward_list<T>>("forward_list", payload, n);
+        runContainer<std::list<T>>("list", payload, n);
+        runContainer<std::vector<T>>("vector", payload, n);
+    }
+    
+}
+
+void writeJson(std::ostream & out) {
+    
+    char date[64];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    
+    out << "{\n"
+        << "  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+        << "    \"library_build_type\": \"release\"\n"
+#else
+        << "    \"library_build_type\": \"debug\"\n"
+#endif
+        << "  },\n"
+        << "  \"benchmarks\": [\n";
+    
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result & r = results[i];
+        out << "    {\n"
+            << "      \"name\": \"" << r.name << "\",\n"
+            << "      \"run_name\": \"" << r.name << "\",\n"
+            << "      \"run_type\": \"iteration\",\n"
+            << "      \"iterations\": " << r.iterations << ",\n"
+            << std::fixed << std::setprecision(3)
+            << "      \"real_time\": " << r.nsPerOp << ",\n"
+            << "      \"cpu_time\": " << r.nsPerOp << ",\n"
+            << "      \"time_unit\": \"ns\"\n"
+            << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    
+    out << "  ]\n"
+        << "}" << std::endl;
+    
+}
+
+int main(int argc, const char * argv[]) {
+    
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--max-size") == 0) {
+            options.maxSize = std::strtoull(argv[i + 1], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--filter") == 0) {
+            options.filter = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--out") == 0) {
+            options.out = argv[i + 1];
+        } else {
+            std::cerr << "Unknown option " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    
+    runPayload<int>("int");
+    runPayload<Pod64>("pod64");
+    runPayload<std::string>("string");
+    
+    if (options.out.empty()) {
+        writeJson(std::cout);
+    } else {
+        std::ofstream file(options.out);
+        writeJson(file);
+    }
+    
+}
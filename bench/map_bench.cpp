@@ -0,0 +1,100 @@
+//
+//  map_bench.cpp
+//  linked_list
+//
+//  Compares the old index-based map (at(i) per element, which re-walks the
+//  chain from head every time) with List<T>::map/fold/filter, which walk the
+//  nodes once.
+//
+//  Build: g++ -std=c++20 -O2 -I.. map_bench.cpp -o map_bench
+//  Usage: ./map_bench [max indexed size, default 100000]
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include "list.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+template<typename Fun>
+double measure(Fun fun) {
+    
+    const auto start = Clock::now();
+    fun();
+    const auto end = Clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+    
+}
+
+/* The pre-iterator implementation of List<T>::map, kept as a baseline */
+List<int> indexedMap(const List<int> & list, int (*fun)(int)) {
+    
+    List<int> l;
+    
+    for (size_t i = 0; i < list.size(); ++i) {
+        l.push_back(fun(list.at(i)));
+    }
+    
+    return l;
+    
+}
+
+int square(const int i) {
+    return i * i;
+}
+
+int main(int argc, const char * argv[]) {
+    
+    const size_t maxIndexed = argc > 1 ? std::strtoul(argv[1], nullptr, 10)
+                                       : 100000;
+    
+    std::cout << std::setw(10) << "size"
+              << std::setw(16) << "indexed map ms"
+              << std::setw(12) << "map ms"
+              << std::setw(12) << "fold ms"
+              << std::setw(12) << "filter ms" << std::endl;
+    
+    volatile long long sink = 0;
+    
+    for (size_t size = 1000; size <= 1000000; size *= 10) {
+        
+        List<int> list;
+        for (size_t i = 0; i < size; ++i) {
+            list.push_back(int(i));
+        }
+        
+        std::cout << std::setw(10) << size << std::setw(16);
+        
+        if (size <= maxIndexed) {
+            const double indexed = measure([&]() {
+                sink = sink + indexedMap(list, square).size();
+            });
+            std::cout << std::fixed << std::setprecision(3) << indexed;
+        } else {
+            std::cout << "skipped";
+        }
+        
+        const double map = measure([&]() {
+            sink = sink + list.map(square).size();
+        });
+        const double fold = measure([&]() {
+            sink = sink + list.fold<long long>([](long long & acc, const int i) {
+                acc += i;
+            }, 0);
+        });
+        const double filter = measure([&]() {
+            sink = sink + list.filter([](const int i) {
+                return not (i % 2);
+            }).size();
+        });
+        
+        std::cout << std::setw(12) << map
+                  << std::setw(12) << fold
+                  << std::setw(12) << filter << std::endl;
+        
+    }
+    
+}
@@ -0,0 +1,104 @@
+//
+//  mpsc_bench.cpp
+//  linked_list
+//
+//  Producer/consumer throughput of MPSCQueue vs. a mutex guarded List.
+//
+//  Build: g++ -std=c++20 -O2 -pthread -I.. mpsc_bench.cpp -o mpsc_bench
+//
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <optional>
+
+#include "list.hpp"
+#include "mpsc_queue.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+/* The baseline, List behind one mutex */
+class LockedList {
+    
+    std::mutex mutex;
+    List<size_t> list;
+    
+public:
+    
+    void push(const size_t item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        list.push_back(item);
+    }
+    
+    std::optional<size_t> try_pop() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.size() == 0) {
+            return std::nullopt;
+        }
+        return list.pop_front();
+    }
+    
+};
+
+/* Pushes ops items from producers threads, one consumer pops them one */
+/* at a time, returns millions of items per second                     */
+template<typename Queue>
+double throughput(const size_t producers, const size_t ops) {
+    
+    Queue queue;
+    std::atomic<bool> go = false;
+    std::vector<std::thread> threads;
+    
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, &go, producers, ops]() {
+            while (not go.load()) { }
+            for (size_t i = 0; i < ops / producers; ++i) {
+                queue.push(i);
+            }
+        });
+    }
+    
+    const size_t total = (ops / producers) * producers;
+    size_t received = 0;
+    volatile size_t sink = 0;
+    
+    const auto start = Clock::now();
+    go.store(true);
+    while (received < total) {
+        if (const auto item = queue.try_pop()) {
+            sink = sink + *item;
+            ++received;
+        }
+    }
+    const auto end = Clock::now();
+    
+    for (std::thread & t : threads) {
+        t.join();
+    }
+    
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    return total / seconds / 1e6;
+    
+}
+
+int main() {
+    
+    const size_t ops = 4000000;
+    
+    std::cout << std::setw(10) << "producers"
+              << std::setw(14) << "mutex Mops/s"
+              << std::setw(14) << "mpsc Mops/s" << std::endl;
+    
+    for (size_t producers = 1; producers <= 8; producers *= 2) {
+        std::cout << std::setw(10) << producers
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << throughput<LockedList>(producers, ops)
+                  << std::setw(14) << throughput<MPSCQueue<size_t>>(producers, ops)
+                  << std::endl;
+    }
+    
+}
@@ -0,0 +1,129 @@
+//
+//  prefetch_bench.cpp
+//  linked_list
+//
+//  Traversal heavy operations over lists larger than the caches, with the
+//  nodes scattered across the heap, allocated in order, or carved out of
+//  PoolAllocator chunks. CMake builds it twice, prefetch_bench without and
+//  prefetch_bench_on with LINKED_LIST_PREFETCH, to compare the two.
+//
+//  Build: g++ -std=c++20 -O2 -I.. [-DLINKED_LIST_PREFETCH] prefetch_bench.cpp
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "list.hpp"
+#include "pool_allocator.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+struct Item {
+    size_t key;
+    size_t value;
+    size_t padding[2];
+};
+
+template<typename Fun>
+double measure(Fun fun) {
+    
+    const auto start = Clock::now();
+    fun();
+    const auto end = Clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+    
+}
+
+/* Nodes are allocated in list order, then sorting by a shuffled key */
+/* relinks them so that each next pointer jumps somewhere random     */
+template<typename L>
+L build(const size_t size, const bool scatter) {
+    
+    std::vector<size_t> keys(size);
+    std::iota(keys.begin(), keys.end(), size_t(0));
+    if (scatter) {
+        std::shuffle(keys.begin(), keys.end(), std::mt19937_64(42));
+    }
+    
+    L list;
+    for (size_t i = 0; i < size; ++i) {
+        list.push_back(Item { keys[i], i, { } });
+    }
+    if (scatter) {
+        list.sort([](const Item & a, const Item & b) { return a.key < b.key; });
+    }
+    return list;
+    
+}
+
+template<typename L>
+void run(const std::string & layout, const size_t size, const bool scatter) {
+    
+    volatile size_t sink = 0;
+    L list = build<L>(size, scatter);
+    
+    const double fold = measure([&]() {
+        sink = sink + list.fold([](size_t & acc, const Item & item) {
+            acc += item.value;
+        }, size_t(0));
+    });
+    
+    const double map = measure([&]() {
+        sink = sink + list.map([](const Item & item) { return item.value; }).size();
+    });
+    
+    const double filter = measure([&]() {
+        sink = sink + list.filter([](const Item & item) { return item.value % 2; }).size();
+    });
+    
+    const double copy = measure([&]() {
+        sink = sink + L(list).size();
+    });
+    
+    /* Last, it frees the nodes in list order */
+    const double clear = measure([&]() {
+        list.clear();
+    });
+    
+    std::cout << std::setw(12) << layout
+              << std::fixed << std::setprecision(3)
+              << std::setw(12) << fold
+              << std::setw(12) << map
+              << std::setw(12) << filter
+              << std::setw(12) << copy
+              << std::setw(12) << clear
+              << std::endl;
+    
+}
+
+int main(int argc, const char * argv[]) {
+    
+    const size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    
+#ifdef LINKED_LIST_PREFETCH
+    std::cout << "prefetch on, ";
+#else
+    std::cout << "prefetch off, ";
+#endif
+    std::cout << size << " items of " << sizeof(Item) << " bytes, ms" << std::endl;
+    
+    std::cout << std::setw(12) << "layout"
+              << std::setw(12) << "fold"
+              << std::setw(12) << "map"
+              << std::setw(12) << "filter"
+              << std::setw(12) << "copy"
+              << std::setw(12) << "clear" << std::endl;
+    
+    run<List<Item>>("in order", size, false);
+    run<List<Item>>("scattered", size, true);
+    run<PooledList<Item>>("pooled", size, false);
+    run<PooledList<Item>>("pool/scatter", size, true);
+    
+}
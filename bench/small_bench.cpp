@@ -0,0 +1,111 @@
+//
+//  small_bench.cpp
+//  linked_list
+//
+//  Short lived short lists with the default allocator vs. SmallList, which
+//  keeps its first 8 nodes inside the list object.
+//
+//  Build: g++ -std=c++20 -O2 -I.. small_bench.cpp -o small_bench
+//
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "list.hpp"
+#include "small_list.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+template<typename Fun>
+double measure(Fun fun) {
+    
+    const auto start = Clock::now();
+    fun();
+    const auto end = Clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+    
+}
+
+/* Build a list of size items, sum it, drop it, lists times */
+template<typename L>
+double buildSum(const size_t size, const size_t lists) {
+    
+    volatile size_t sink = 0;
+    
+    return measure([&]() {
+        for (size_t l = 0; l < lists; ++l) {
+            L list;
+            for (size_t i = 0; i < size; ++i) {
+                list.push_back(typename L::value_type(i));
+            }
+            size_t sum = 0;
+            for (const auto & item : list) {
+                sum += size_t(item);
+            }
+            sink = sink + sum;
+        }
+    });
+    
+}
+
+/* A vector of lists filled round robin, so nodes of one list are not */
+/* neighbours on the heap                                             */
+template<typename L>
+double roundRobin(const size_t size, const size_t lists) {
+    
+    volatile size_t sink = 0;
+    
+    return measure([&]() {
+        std::vector<L> all(lists);
+        for (size_t i = 0; i < size; ++i) {
+            for (L & list : all) {
+                list.push_back(typename L::value_type(i));
+            }
+        }
+        for (const L & list : all) {
+            for (const auto & item : list) {
+                sink = sink + size_t(item);
+            }
+        }
+    });
+    
+}
+
+template<typename T>
+void run(const std::string & name) {
+    
+    const size_t items = 8000000;
+    
+    for (size_t size = 1; size <= 32; size *= 2) {
+        
+        const size_t lists = items / size;
+        
+        std::cout << std::setw(10) << name
+                  << std::setw(10) << size
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(14) << buildSum<List<T>>(size, lists)
+                  << std::setw(14) << buildSum<SmallList<T>>(size, lists)
+                  << std::setw(14) << roundRobin<List<T>>(size, lists / 8)
+                  << std::setw(14) << roundRobin<SmallList<T>>(size, lists / 8)
+                  << std::endl;
+        
+    }
+    
+}
+
+int main() {
+    
+    std::cout << std::setw(10) << "payload"
+              << std::setw(10) << "size"
+              << std::setw(14) << "build/sum"
+              << std::setw(14) << "small"
+              << std::setw(14) << "round robin"
+              << std::setw(14) << "small" << std::endl;
+    
+    run<int>("int");
+    run<double>("double");
+    
+}
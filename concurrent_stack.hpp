@@ -0,0 +1,348 @@
+//
+//  concurrent_stack.hpp
+//  linked_list
+//
+//  Lock-free stack (Treiber stack) with the push()/pop_front() semantics of
+//  List<T>, safe to share between threads. The top pointer carries a 16 bit
+//  tag against ABA, and popped nodes are recycled through an internal free
+//  list instead of being freed, so a racing pop never reads freed memory.
+//
+
+#ifndef concurrent_stack_hpp
+#define concurrent_stack_hpp
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "list.hpp"
+
+
+/*************************************************************************/
+/*                                                                       */
+/* ********************************************************************* */
+/* **************************** Declaration **************************** */
+/* ********************************************************************* */
+/*                                                                       */
+/*************************************************************************/
+
+
+/* All member functions may be called concurrently. push() and emplace() */
+/* allocate from any thread, nodes go back to the allocator only when   */
+/* the stack is destroyed                                               */
+
+template <typename T, typename Alloc = std::allocator<T>>
+class ConcurrentStack {
+    
+    static_assert(sizeof(void *) == sizeof(uint64_t),
+                  "ConcurrentStack packs its ABA tag into 64 bit pointers");
+    
+    /* The node outlives its item, next stays a live atomic while the */
+    /* node sits on the free list, which racing pops may still read  */
+    
+    struct Node {
+        
+        std::atomic<Node *> next = nullptr;
+        union { T item; };
+        
+        Node() { }
+        ~Node() { }
+        
+    };
+    
+    typedef Node* node_ptr;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Node>
+        node_allocator;
+    typedef std::allocator_traits<node_allocator> node_traits;
+    
+    /* Tagged pointers, user space addresses fit in the low 48 bits on */
+    /* x86-64 and AArch64 with 4-level paging, the high 16 bits count */
+    /* modifications. create_node() throws on a node above 2^48, as  */
+    /* 5-level paging (LA57) or 52 bit AArch64 addresses may give    */
+    
+    typedef uint64_t tagged_ptr;
+    
+    static constexpr tagged_ptr pointerMask = (uint64_t(1) << 48) - 1;
+    
+    static tagged_ptr pack(node_ptr node, const tagged_ptr previous);
+    static node_ptr pointer(const tagged_ptr tagged);
+    
+    std::atomic<tagged_ptr> top = 0;
+    std::atomic<tagged_ptr> freeList = 0;
+    [[no_unique_address]] node_allocator alloc;
+    
+    /* Node allocation */
+    
+    template<typename... args>
+    node_ptr create_node(args&&... a);
+    void recycle(node_ptr first, node_ptr last);
+    
+    /* Tagged stack operations, shared by the stack and its free list */
+    
+    static void push_chain(std::atomic<tagged_ptr> & head,
+                           node_ptr first,
+                           node_ptr last);
+    static node_ptr pop_node(std::atomic<tagged_ptr> & head);
+    
+public:
+    
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    
+    void push(const T & item);
+    void push(T && item);
+    
+    template<typename... args>
+    void emplace(args&&... a);
+    
+    std::optional<T> pop();
+    
+    /* Detaches every node at once, the top of the stack comes first */
+    
+    List<T, Alloc> pop_all();
+    
+    bool empty() const;
+    
+    /* Constructors */
+    
+    ConcurrentStack();
+    explicit ConcurrentStack(const Alloc & allocator);
+    ConcurrentStack(const ConcurrentStack<T, Alloc> &) = delete;
+    ConcurrentStack<T, Alloc> &
+    operator=(const ConcurrentStack<T, Alloc> &) = delete;
+    
+    /* Destructor */
+    
+    ~ConcurrentStack();
+    
+};
+
+/**************************************************************************/
+/*                                                                        */
+/* ********************************************************************** */
+/* *************************** Implementation *************************** */
+/* ********************************************************************** */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**********************/
+/*      Internal      */
+/**********************/
+
+/* Tagged pointers */
+
+template<typename T, typename Alloc>
+typename ConcurrentStack<T, Alloc>::tagged_ptr
+ConcurrentStack<T, Alloc>::pack(node_ptr node, const tagged_ptr previous) {
+    assert((reinterpret_cast<uintptr_t>(node) & ~pointerMask) == 0);
+    const tagged_ptr tag = (previous & ~pointerMask) + (pointerMask + 1);
+    return tag | reinterpret_cast<uintptr_t>(node);
+}
+
+template<typename T, typename Alloc>
+typename ConcurrentStack<T, Alloc>::node_ptr
+ConcurrentStack<T, Alloc>::pointer(const tagged_ptr tagged) {
+    return reinterpret_cast<node_ptr>(tagged & pointerMask);
+}
+
+/* Node allocation */
+
+template<typename T, typename Alloc>
+template<typename... args>
+typename ConcurrentStack<T, Alloc>::node_ptr
+ConcurrentStack<T, Alloc>::create_node(args&&... a) {
+    
+    node_ptr node = pop_node(freeList);
+    if (node == nullptr) {
+        node = node_traits::allocate(alloc, 1);
+        if (reinterpret_cast<uintptr_t>(node) & ~pointerMask) {
+            node_traits::deallocate(alloc, node, 1);
+            throw std::runtime_error("ConcurrentStack node address does not "
+                                     "fit in 48 bits");
+        }
+        node_traits::construct(alloc, node);
+    }
+    
+    try {
+        node_traits::construct(alloc, std::addressof(node->item),
+                              std::forward<args>(a)...);
+    } catch (...) {
+        recycle(node, node);
+        throw;
+    }
+    return node;
+    
+}
+
+template<typename T, typename Alloc>
+void ConcurrentStack<T, Alloc>::recycle(node_ptr first, node_ptr last) {
+    push_chain(freeList, first, last);
+}
+
+/* Tagged stack operations */
+
+template<typename T, typename Alloc>
+void ConcurrentStack<T, Alloc>::push_chain(std::atomic<tagged_ptr> & head,
+                                           node_ptr first,
+                                           node_ptr last) {
+    
+    tagged_ptr old = head.load(std::memory_order_relaxed);
+    do {
+        last->next.store(pointer(old), std::memory_order_relaxed);
+    } while (not head.compare_exchange_weak(old, pack(first, old),
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed));
+    
+}
+
+template<typename T, typename Alloc>
+typename ConcurrentStack<T, Alloc>::node_ptr
+ConcurrentStack<T, Alloc>::pop_node(std::atomic<tagged_ptr> & head) {
+    
+    tagged_ptr old = head.load(std::memory_order_acquire);
+    
+    while (pointer(old) != nullptr) {
+        
+        /* node may be popped and reused before the exchange, then next */
+        /* is stale, but the tag has moved on and the exchange fails   */
+        
+        node_ptr node = pointer(old);
+        node_ptr next = node->next.load(std::memory_order_relaxed);
+        if (head.compare_exchange_weak(old, pack(next, old),
+                                       std::memory_order_acquire,
+                                       std::memory_order_acquire)) {
+            return node;
+        }
+        
+    }
+    
+    return nullptr;
+    
+}
+
+
+/**********************/
+/*       Public       */
+/**********************/
+
+template<typename T, typename Alloc>
+void ConcurrentStack<T, Alloc>::push(const T & item) {
+    node_ptr node = create_node(item);
+    push_chain(top, node, node);
+}
+
+template<typename T, typename Alloc>
+void ConcurrentStack<T, Alloc>::push(T && item) {
+    node_ptr node = create_node(std::move(item));
+    push_chain(top, node, node);
+}
+
+template<typename T, typename Alloc>
+template<typename... args>
+void ConcurrentStack<T, Alloc>::emplace(args&&... a) {
+    node_ptr node = create_node(std::forward<args>(a)...);
+    push_chain(top, node, node);
+}
+
+template<typename T, typename Alloc>
+std::optional<T> ConcurrentStack<T, Alloc>::pop() {
+    
+    node_ptr node = pop_node(top);
+    if (node == nullptr) {
+        return std::nullopt;
+    }
+    
+    std::optional<T> retval(std::move(node->item));
+    node_traits::destroy(alloc, std::addressof(node->item));
+    recycle(node, node);
+    return retval;
+    
+}
+
+template<typename T, typename Alloc>
+List<T, Alloc> ConcurrentStack<T, Alloc>::pop_all() {
+    
+    /* One successful exchange detaches the chain, retried only if */
+    /* another thread changed top in between                      */
+    
+    tagged_ptr old = top.load(std::memory_order_relaxed);
+    while (not top.compare_exchange_weak(old, pack(nullptr, old),
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed));
+    
+    List<T, Alloc> list{Alloc(alloc)};
+    node_ptr first = pointer(old);
+    if (first == nullptr) {
+        return list;
+    }
+    
+    /* The chain is private now, move the items out and recycle it */
+    
+    node_ptr last = first;
+    try {
+        for (node_ptr node = first; node != nullptr;
+             node = node->next.load(std::memory_order_relaxed)) {
+            last = node;
+            list.push_back(std::move(node->item));
+            node_traits::destroy(alloc, std::addressof(node->item));
+        }
+    } catch (...) {
+        for (node_ptr node = last; node != nullptr;
+             node = node->next.load(std::memory_order_relaxed)) {
+            node_traits::destroy(alloc, std::addressof(node->item));
+            last = node;
+        }
+        recycle(first, last);
+        throw;
+    }
+    
+    recycle(first, last);
+    return list;
+    
+}
+
+template<typename T, typename Alloc>
+bool ConcurrentStack<T, Alloc>::empty() const {
+    return pointer(top.load(std::memory_order_acquire)) == nullptr;
+}
+
+/* Constructors */
+
+template<typename T, typename Alloc>
+ConcurrentStack<T, Alloc>::ConcurrentStack() { }
+
+template<typename T, typename Alloc>
+ConcurrentStack<T, Alloc>::ConcurrentStack(const Alloc & allocator)
+    : alloc(allocator) { }
+
+/* Destructor */
+
+template<typename T, typename Alloc>
+ConcurrentStack<T, Alloc>::~ConcurrentStack() {
+    
+    node_ptr node = pointer(top.load(std::memory_order_acquire));
+    while (node != nullptr) {
+        node_ptr next = node->next.load(std::memory_order_relaxed);
+        node_traits::destroy(alloc, std::addressof(node->item));
+        node_traits::destroy(alloc, node);
+        node_traits::deallocate(alloc, node, 1);
+        node = next;
+    }
+    
+    node = pointer(freeList.load(std::memory_order_acquire));
+    while (node != nullptr) {
+        node_ptr next = node->next.load(std::memory_order_relaxed);
+        node_traits::destroy(alloc, node);
+        node_traits::deallocate(alloc, node, 1);
+        node = next;
+    }
+    
+}
+
+#endif /* concurrent_stack_hpp */
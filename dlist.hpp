@@ -0,0 +1,1203 @@
+//
+//  dlist.hpp
+//  linked_list
+//
+//  Doubly linked counterpart of List<T, Alloc> with its indexed, push/pop,
+//  append, assignment, swap and map/fold/filter/remove_if API, plus O(1)
+//  pop_back, bidirectional/reverse iterators and O(1) insertion and removal
+//  by iterator. Costs one extra pointer per node. List's *_after operations
+//  and sort/merge/unique/reverse have no DList counterpart.
+//
+
+#ifndef dlist_hpp
+#define dlist_hpp
+
+#include <memory>
+#include <cstddef>
+#include <stdexcept>
+#include <iterator>
+#include <functional>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
+#include "list.hpp"
+
+
+/*************************************************************************/
+/*                                                                       */
+/* ********************************************************************* */
+/* **************************** Declaration **************************** */
+/* ********************************************************************* */
+/*                                                                       */
+/*************************************************************************/
+
+
+template <typename T, typename Alloc = std::allocator<T>>
+class DList {
+    
+    static_assert(not allocator_stores_nodes_inline<Alloc>::value,
+                  "DList moves nodes between lists, use List for inline storage");
+    
+    /* The list owns a sentinel link, so the chain is circular and end() */
+    /* can be decremented without special cases                          */
+    
+    struct Link {
+        
+        Link * prev = this;
+        Link * next = this;
+        
+    };
+    
+    struct Node : Link {
+        
+        T item;
+        
+        template<typename... args>
+        Node(std::in_place_t, args&&... a);
+        
+        Node(const Node & node) = delete;
+        Node & operator=(const Node & node) = delete;
+        
+    };
+    
+    typedef Link* link_ptr;
+    typedef Node* node_ptr;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Node>
+        node_allocator;
+    typedef std::allocator_traits<node_allocator> node_traits;
+    
+    template<typename, typename> friend class DList;
+    
+    size_t len = 0;
+    Link anchor;
+    [[no_unique_address]] node_allocator alloc;
+    
+    /* Node allocation */
+    
+    template<typename... args>
+    node_ptr create_node(args&&... a);
+    void destroy_node(link_ptr node);
+    bool shares_allocator(const DList<T, Alloc> & l) const;
+    
+    /* Chain copying, copy_chain() returns count new nodes linked to */
+    /* each other only, and frees its partial copy if T throws       */
+    
+    link_ptr copy_chain(link_ptr first, const size_t count, link_ptr & last);
+    void destroy_chain(link_ptr first);
+    
+    /* Node retrieval */
+    
+    link_ptr node_at(const size_t index) const;
+    
+    /* Utility */
+    
+    void checkIndexRange(const size_t index) const;
+    void steal(DList<T, Alloc> & l);
+    
+    /* Node insertion and removal */
+    
+    link_ptr link_before(link_ptr pos, link_ptr node);
+    void link_chain_before(link_ptr pos, link_ptr first, link_ptr last,
+                           const size_t count);
+    link_ptr unlink(link_ptr node);
+    
+    /* Iterators */
+    
+    template<bool Const>
+    class Iterator {
+        
+        friend class DList;
+        template<bool> friend class Iterator;
+        
+        link_ptr node = nullptr;
+        
+        explicit Iterator(link_ptr node);
+        
+    public:
+        
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef std::bidirectional_iterator_tag iterator_concept;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::conditional_t<Const, const T, T> * pointer;
+        typedef std::conditional_t<Const, const T, T> & reference;
+        
+        Iterator() = default;
+        
+        template<bool OtherConst> requires (Const and not OtherConst)
+        Iterator(const Iterator<OtherConst> & it);
+        
+        reference operator*() const;
+        pointer operator->() const;
+        
+        Iterator & operator++();
+        Iterator operator++(int);
+        Iterator & operator--();
+        Iterator operator--(int);
+        
+        bool operator==(const Iterator & other) const;
+        
+    };
+    
+public:
+    
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef T & reference;
+    typedef const T & const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    
+    /* Allocator */
+    
+    allocator_type get_allocator() const;
+    
+    /* Iterators */
+    
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator rend() const;
+    const_reverse_iterator crbegin() const;
+    const_reverse_iterator crend() const;
+    
+    /* Element access */
+    
+    T & at(const size_t index);
+    T & operator[](const size_t index);
+    const T & at(const size_t index) const;
+    const T & operator[](const size_t index) const;
+    
+    T & first();
+    const T & first() const;
+    
+    T & last();
+    const T & last() const;
+    
+    /* Push back */
+    
+    DList<T, Alloc> & push_back(const T & item);
+    DList<T, Alloc> & push_back(T && item);
+    
+    template<typename... args>
+    requires std::constructible_from<T, args&&...>
+    DList<T, Alloc> & push_back(args&&... a);
+    
+    template<typename... args>
+    T & emplace_back(args&&... a);
+    
+    /* Push front */
+    
+    DList<T, Alloc> & push(const T & item);
+    DList<T, Alloc> & push(T && item);
+    
+    template<typename... args>
+    requires std::constructible_from<T, args&&...>
+    DList<T, Alloc> & push(args&&... a);
+    
+    template<typename... args>
+    T & emplace_front(args&&... a);
+    
+    /* Insert at index */
+    
+    DList<T, Alloc> & insert(const size_t index, const T & item);
+    DList<T, Alloc> & insert(const size_t index, T && item);
+    
+    template<typename... args>
+    requires std::constructible_from<T, args&&...>
+    DList<T, Alloc> & insert(const size_t index, args&&... a);
+    
+    template<typename... args>
+    T & emplace(const size_t index, args&&... a);
+    
+    /* Insert before iterator */
+    
+    iterator insert(const_iterator pos, const T & item);
+    iterator insert(const_iterator pos, T && item);
+    
+    template<typename... args>
+    iterator emplace(const_iterator pos, args&&... a);
+    
+    /* Remove elements */
+    
+    T pop_front();
+    T pop_back();
+    T remove(const size_t index);
+    
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    
+    /* List concatenation */
+    
+    DList<T, Alloc> concatenate(const DList<T, Alloc> & l) const;
+    DList<T, Alloc> operator+(const DList<T, Alloc> & l) const;
+    DList<T, Alloc> concatenate(DList<T, Alloc> && l) const;
+    DList<T, Alloc> operator+(DList<T, Alloc> && l) const;
+    
+    /* Append list */
+    
+    DList<T, Alloc> & append(const DList<T, Alloc> & l);
+    DList<T, Alloc> & operator+=(const DList<T, Alloc> & l);
+    DList<T, Alloc> & append(DList<T, Alloc> && l);
+    DList<T, Alloc> & operator+=(DList<T, Alloc> && l);
+    
+    /* Assignment */
+    
+    DList<T, Alloc> & assign(const DList<T, Alloc> & l);
+    DList<T, Alloc> & operator=(const DList<T, Alloc> & l);
+    DList<T, Alloc> & assign(DList<T, Alloc> && l)
+        noexcept(node_traits::propagate_on_container_move_assignment::value or
+                 node_traits::is_always_equal::value);
+    DList<T, Alloc> & operator=(DList<T, Alloc> && l)
+        noexcept(node_traits::propagate_on_container_move_assignment::value or
+                 node_traits::is_always_equal::value);
+    
+    void swap(DList<T, Alloc> & l) noexcept;
+    
+    /* Utility */
+    
+    size_t size() const;
+    
+    template<typename Fun,
+             typename U = std::remove_cvref_t<
+                 std::invoke_result_t<Fun &, const T &>>>
+    requires std::invocable<Fun &, const T &>
+    DList<U, typename std::allocator_traits<Alloc>::template rebind_alloc<U>>
+    map(Fun fun) const;
+    
+    template<typename Acc, typename Fun>
+    requires std::invocable<Fun &, Acc &, const T &>
+    Acc fold(Fun fun, Acc initVal) const;
+    
+    template<typename Fun>
+    requires std::predicate<Fun &, const T &>
+    DList<T, Alloc> filter(Fun fun) const;
+    
+    template<typename Fun>
+    requires std::predicate<Fun &, const T &>
+    size_t remove_if(Fun fun);
+    
+    template<typename Fun>
+    requires std::predicate<Fun &, const T &>
+    size_t retain(Fun fun);
+    
+    DList<T, Alloc> & clear();
+    
+    /* Constructors */
+    
+    DList();
+    explicit DList(const Alloc & allocator);
+    DList(const DList<T, Alloc> & orig);
+    DList(DList<T, Alloc> && orig) noexcept;
+    
+    /* Destructor */
+    
+    ~DList();
+    
+};
+
+template<typename T, typename Alloc>
+void swap(DList<T, Alloc> & lhs, DList<T, Alloc> & rhs) noexcept;
+
+/**************************************************************************/
+/*                                                                        */
+/* ********************************************************************** */
+/* *************************** Implementation *************************** */
+/* ********************************************************************** */
+/*                                                                        */
+/**************************************************************************/
+
+
+/********************************************************************/
+/*                                                                  */
+/*                               Node                               */
+/*                                                                  */
+/********************************************************************/
+
+template<typename T, typename Alloc>
+template <typename... args>
+DList<T, Alloc>::Node::Node(std::in_place_t, args&&... a)
+    : item(std::forward<args>(a)...) { }
+
+
+/********************************************************************/
+/*                                                                  */
+/*                             Iterator                             */
+/*                                                                  */
+/********************************************************************/
+
+template<typename T, typename Alloc>
+template<bool Const>
+DList<T, Alloc>::Iterator<Const>::Iterator(link_ptr node) : node(node) { }
+
+template<typename T, typename Alloc>
+template<bool Const>
+template<bool OtherConst> requires (Const and not OtherConst)
+DList<T, Alloc>::Iterator<Const>::Iterator(const Iterator<OtherConst> & it)
+    : node(it.node) { }
+
+template<typename T, typename Alloc>
+template<bool Const>
+typename DList<T, Alloc>::template Iterator<Const>::reference
+DList<T, Alloc>::Iterator<Const>::operator*() const {
+    return static_cast<node_ptr>(node)->item;
+}
+
+template<typename T, typename Alloc>
+template<bool Const>
+typename DList<T, Alloc>::template Iterator<Const>::pointer
+DList<T, Alloc>::Iterator<Const>::operator->() const {
+    return &static_cast<node_ptr>(node)->item;
+}
+
+template<typename T, typename Alloc>
+template<bool Const>
+typename DList<T, Alloc>::template Iterator<Const> &
+DList<T, Alloc>::Iterator<Const>::operator++() {
+    node = node->next;
+    return *this;
+}
+
+template<typename T, typename Alloc>
+template<bool Const>
+typename DList<T, Alloc>::template Iterator<Const>
+DList<T, Alloc>::Iterator<Const>::operator++(int) {
+    Iterator copy = *this;
+    node = node->next;
+    return copy;
+}
+
+template<typename T, typename Alloc>
+template<bool Const>
+typename DList<T, Alloc>::template Iterator<Const> &
+DList<T, Alloc>::Iterator<Const>::operator--() {
+    node = node->prev;
+    return *this;
+}
+
+template<typename T, typename Alloc>
+template<bool Const>
+typename DList<T, Alloc>::template Iterator<Const>
+DList<T, Alloc>::Iterator<Const>::operator--(int) {
+    Iterator copy = *this;
+    node = node->prev;
+    return copy;
+}
+
+template<typename T, typename Alloc>
+template<bool Const>
+bool DList<T, Alloc>::Iterator<Const>::operator==(const Iterator & other) const {
+    return node == other.node;
+}
+
+
+/*********************************************************************/
+/*                                                                   */
+/*                           DList<T, Alloc>                         */
+/*                                                                   */
+/*********************************************************************/
+
+/**********************/
+/*      Internal      */
+/**********************/
+
+/* Node allocation */
+
+template<typename T, typename Alloc>
+template<typename... args>
+typename DList<T, Alloc>::node_ptr DList<T, Alloc>::create_node(args&&... a) {
+    
+    node_ptr node = node_traits::allocate(alloc, 1);
+    try {
+        node_traits::construct(alloc, node, std::in_place,
+                               std::forward<args>(a)...);
+    } catch (...) {
+        node_traits::deallocate(alloc, node, 1);
+        throw;
+    }
+    return node;
+    
+}
+
+template<typename T, typename Alloc>
+void DList<T, Alloc>::destroy_node(link_ptr node) {
+    node_ptr ptr = static_cast<node_ptr>(node);
+    node_traits::destroy(alloc, ptr);
+    node_traits::deallocate(alloc, ptr, 1);
+}
+
+template<typename T, typename Alloc>
+bool DList<T, Alloc>::shares_allocator(const DList<T, Alloc> & l) const {
+    if constexpr (node_traits::is_always_equal::value) {
+        return true;
+    } else {
+        return alloc == l.alloc;
+    }
+}
+
+/* Chain copying */
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::link_ptr
+DList<T, Alloc>::copy_chain(link_ptr first, const size_t count, link_ptr & last) {
+    
+    link_ptr copy = nullptr;
+    last = nullptr;
+    
+    try {
+        for (size_t i = 0; i < count; ++i, first = first->next) {
+            link_ptr node = create_node(static_cast<node_ptr>(first)->item);
+            node->prev = last;
+            node->next = nullptr;
+            if (last) {
+                last->next = node;
+            } else {
+                copy = node;
+            }
+            last = node;
+        }
+    } catch (...) {
+        destroy_chain(copy);
+        throw;
+    }
+    
+    return copy;
+    
+}
+
+/* Destroys nodes up to the first null next link */
+
+template<typename T, typename Alloc>
+void DList<T, Alloc>::destroy_chain(link_ptr first) {
+    while (first != nullptr) {
+        link_ptr next = first->next;
+        destroy_node(first);
+        first = next;
+    }
+}
+
+/* Node retrieval */
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::link_ptr
+DList<T, Alloc>::node_at(const size_t index) const {
+    
+    link_ptr ptr;
+    
+    if (index < len / 2) {
+        ptr = anchor.next;
+        for (size_t i = 0; i < index; ++i) {
+            ptr = ptr->next;
+        }
+    } else {
+        ptr = anchor.prev;
+        for (size_t i = len - 1; i > index; --i) {
+            ptr = ptr->prev;
+        }
+    }
+    
+    return ptr;
+    
+}
+
+/* Utility */
+
+template<typename T, typename Alloc>
+void DList<T, Alloc>::checkIndexRange(const size_t index) const {
+    if (index >= len) {
+        throw std::out_of_range("List index out of range.");
+    }
+}
+
+template<typename T, typename Alloc>
+void DList<T, Alloc>::steal(DList<T, Alloc> & l) {
+    
+    if (l.len == 0) {
+        return;
+    }
+    
+    anchor.next = l.anchor.next;
+    anchor.prev = l.anchor.prev;
+    anchor.next->prev = &anchor;
+    anchor.prev->next = &anchor;
+    len = l.len;
+    
+    l.anchor.next = &l.anchor;
+    l.anchor.prev = &l.anchor;
+    l.len = 0;
+    
+}
+
+/* Node insertion and removal */
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::link_ptr
+DList<T, Alloc>::link_before(link_ptr pos, link_ptr node) {
+    node->next = pos;
+    node->prev = pos->prev;
+    pos->prev->next = node;
+    pos->prev = node;
+    ++len;
+    return node;
+}
+
+template<typename T, typename Alloc>
+void DList<T, Alloc>::link_chain_before(link_ptr pos,
+                                        link_ptr first,
+                                        link_ptr last,
+                                        const size_t count) {
+    first->prev = pos->prev;
+    last->next = pos;
+    pos->prev->next = first;
+    pos->prev = last;
+    len += count;
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::link_ptr DList<T, Alloc>::unlink(link_ptr node) {
+    link_ptr next = node->next;
+    node->prev->next = next;
+    next->prev = node->prev;
+    --len;
+    return next;
+}
+
+/**********************/
+/*       Public       */
+/**********************/
+
+/* Allocator */
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::allocator_type DList<T, Alloc>::get_allocator() const {
+    return allocator_type(alloc);
+}
+
+/* Iterators */
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::iterator DList<T, Alloc>::begin() {
+    return iterator(anchor.next);
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::iterator DList<T, Alloc>::end() {
+    return iterator(&anchor);
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::const_iterator DList<T, Alloc>::begin() const {
+    return const_iterator(anchor.next);
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::const_iterator DList<T, Alloc>::end() const {
+    return const_iterator(const_cast<link_ptr>(&anchor));
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::const_iterator DList<T, Alloc>::cbegin() const {
+    return begin();
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::const_iterator DList<T, Alloc>::cend() const {
+    return end();
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::reverse_iterator DList<T, Alloc>::rbegin() {
+    return reverse_iterator(end());
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::reverse_iterator DList<T, Alloc>::rend() {
+    return reverse_iterator(begin());
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::const_reverse_iterator
+DList<T, Alloc>::rbegin() const {
+    return const_reverse_iterator(end());
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::const_reverse_iterator
+DList<T, Alloc>::rend() const {
+    return const_reverse_iterator(begin());
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::const_reverse_iterator
+DList<T, Alloc>::crbegin() const {
+    return rbegin();
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::const_reverse_iterator
+DList<T, Alloc>::crend() const {
+    return rend();
+}
+
+/* Element access */
+
+template<typename T, typename Alloc>
+T & DList<T, Alloc>::at(const size_t index) {
+    checkIndexRange(index);
+    return static_cast<node_ptr>(node_at(index))->item;
+}
+
+template<typename T, typename Alloc>
+T & DList<T, Alloc>::operator[](const size_t index) {
+    return at(index);
+}
+
+template<typename T, typename Alloc>
+const T & DList<T, Alloc>::at(const size_t index) const {
+    checkIndexRange(index);
+    return static_cast<node_ptr>(node_at(index))->item;
+}
+
+template<typename T, typename Alloc>
+const T & DList<T, Alloc>::operator[](const size_t index) const {
+    return at(index);
+}
+
+template<typename T, typename Alloc>
+T & DList<T, Alloc>::first() {
+    
+    if (len == 0) {
+        throw std::out_of_range("Calling DList<T>::first() on an empty DList");
+    }
+    
+    return static_cast<node_ptr>(anchor.next)->item;
+    
+}
+
+template<typename T, typename Alloc>
+const T & DList<T, Alloc>::first() const {
+    
+    if (len == 0) {
+        throw std::out_of_range("Calling DList<T>::first() on an empty DList");
+    }
+    
+    return static_cast<node_ptr>(anchor.next)->item;
+    
+}
+
+template<typename T, typename Alloc>
+T & DList<T, Alloc>::last() {
+    
+    if (len == 0) {
+        throw std::out_of_range("Calling DList<T>::last() on an empty DList");
+    }
+    
+    return static_cast<node_ptr>(anchor.prev)->item;
+    
+}
+
+template<typename T, typename Alloc>
+const T & DList<T, Alloc>::last() const {
+    
+    if (len == 0) {
+        throw std::out_of_range("Calling DList<T>::last() on an empty DList");
+    }
+    
+    return static_cast<node_ptr>(anchor.prev)->item;
+    
+}
+
+/* Item insertion */
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::push_back(const T & item) {
+    emplace_back(item);
+    return *this;
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::push_back(T && item) {
+    emplace_back(std::move(item));
+    return *this;
+}
+
+template<typename T, typename Alloc>
+template<typename... args>
+requires std::constructible_from<T, args&&...>
+DList<T, Alloc> & DList<T, Alloc>::push_back(args&&... a) {
+    emplace_back(std::forward<args>(a)...);
+    return *this;
+}
+
+template<typename T, typename Alloc>
+template<typename... args>
+T & DList<T, Alloc>::emplace_back(args&&... a) {
+    return *emplace(cend(), std::forward<args>(a)...);
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::push(const T & item) {
+    emplace_front(item);
+    return *this;
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::push(T && item) {
+    emplace_front(std::move(item));
+    return *this;
+}
+
+template<typename T, typename Alloc>
+template<typename... args>
+requires std::constructible_from<T, args&&...>
+DList<T, Alloc> & DList<T, Alloc>::push(args&&... a) {
+    emplace_front(std::forward<args>(a)...);
+    return *this;
+}
+
+template<typename T, typename Alloc>
+template<typename... args>
+T & DList<T, Alloc>::emplace_front(args&&... a) {
+    return *emplace(cbegin(), std::forward<args>(a)...);
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::insert(const size_t index, const T & item) {
+    emplace(index, item);
+    return *this;
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::insert(const size_t index, T && item) {
+    emplace(index, std::move(item));
+    return *this;
+}
+
+template<typename T, typename Alloc>
+template<typename... args>
+requires std::constructible_from<T, args&&...>
+DList<T, Alloc> & DList<T, Alloc>::insert(const size_t index, args&&... a) {
+    emplace(index, std::forward<args>(a)...);
+    return *this;
+}
+
+/* Same semantics as List<T>::insert, the last index appends */
+
+template<typename T, typename Alloc>
+template<typename... args>
+T & DList<T, Alloc>::emplace(const size_t index, args&&... a) {
+    
+    checkIndexRange(index);
+    if (index == len - 1) {
+        return emplace_back(std::forward<args>(a)...);
+    }
+    
+    const_iterator pos(node_at(index));
+    return *emplace(pos, std::forward<args>(a)...);
+    
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::iterator
+DList<T, Alloc>::insert(const_iterator pos, const T & item) {
+    return emplace(pos, item);
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::iterator
+DList<T, Alloc>::insert(const_iterator pos, T && item) {
+    return emplace(pos, std::move(item));
+}
+
+template<typename T, typename Alloc>
+template<typename... args>
+typename DList<T, Alloc>::iterator
+DList<T, Alloc>::emplace(const_iterator pos, args&&... a) {
+    node_ptr node = create_node(std::forward<args>(a)...);
+    return iterator(link_before(pos.node, node));
+}
+
+/* Item extraction */
+
+template<typename T, typename Alloc>
+T DList<T, Alloc>::pop_front() {
+    
+    if (len == 0) {
+        throw std::runtime_error("Calling DList<T>::pop_front() on an empty "
+                                 "DList");
+    }
+    
+    link_ptr node = anchor.next;
+    T retval(std::move(static_cast<node_ptr>(node)->item));
+    unlink(node);
+    destroy_node(node);
+    return retval;
+    
+}
+
+template<typename T, typename Alloc>
+T DList<T, Alloc>::pop_back() {
+    
+    if (len == 0) {
+        throw std::runtime_error("Calling DList<T>::pop_back() on an empty "
+                                 "DList");
+    }
+    
+    link_ptr node = anchor.prev;
+    T retval(std::move(static_cast<node_ptr>(node)->item));
+    unlink(node);
+    destroy_node(node);
+    return retval;
+    
+}
+
+template<typename T, typename Alloc>
+T DList<T, Alloc>::remove(const size_t index) {
+    
+    checkIndexRange(index);
+    
+    link_ptr node = node_at(index);
+    T retval(std::move(static_cast<node_ptr>(node)->item));
+    unlink(node);
+    destroy_node(node);
+    return retval;
+    
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::iterator DList<T, Alloc>::erase(const_iterator pos) {
+    link_ptr next = unlink(pos.node);
+    destroy_node(pos.node);
+    return iterator(next);
+}
+
+template<typename T, typename Alloc>
+typename DList<T, Alloc>::iterator
+DList<T, Alloc>::erase(const_iterator first, const_iterator last) {
+    
+    while (first != last) {
+        first = erase(first);
+    }
+    
+    return iterator(last.node);
+    
+}
+
+/* List concatenation */
+
+template<typename T, typename Alloc>
+DList<T, Alloc> DList<T, Alloc>::concatenate(const DList<T, Alloc> & l) const {
+    DList<T, Alloc> copy(*this);
+    copy += l;
+    return copy;
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> DList<T, Alloc>::operator+(const DList<T, Alloc> & l) const {
+    return concatenate(l);
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> DList<T, Alloc>::concatenate(DList<T, Alloc> && l) const {
+    DList<T, Alloc> copy(*this);
+    copy += std::move(l);
+    return copy;
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> DList<T, Alloc>::operator+(DList<T, Alloc> && l) const {
+    return concatenate(std::move(l));
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::append(const DList<T, Alloc> & l) {
+    
+    if (l.len == 0) {
+        return *this;
+    }
+    
+    /* Copied before linking, as in List::append() */
+    
+    link_ptr last;
+    link_ptr first = copy_chain(l.anchor.next, l.len, last);
+    link_chain_before(&anchor, first, last, l.len);
+    
+    return *this;
+    
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::operator+=(const DList<T, Alloc> & l) {
+    return append(l);
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::append(DList<T, Alloc> && l) {
+    
+    if (&l == this or l.len == 0) {
+        return *this;
+    }
+    
+    if (not shares_allocator(l)) {
+        for (T & item : l) {
+            push_back(std::move(item));
+        }
+        l.clear();
+        return *this;
+    }
+    
+    link_chain_before(&anchor, l.anchor.next, l.anchor.prev, l.len);
+    
+    l.anchor.next = &l.anchor;
+    l.anchor.prev = &l.anchor;
+    l.len = 0;
+    
+    return *this;
+    
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::operator+=(DList<T, Alloc> && l) {
+    return append(std::move(l));
+}
+
+/* Assignment */
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::assign(const DList<T, Alloc> & l) {
+    
+    if (&l == this) {
+        return *this;
+    }
+    
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+        if (not shares_allocator(l)) {
+            DList<T, Alloc> copy{Alloc(l.alloc)};
+            copy.append(l);
+            clear();
+            alloc = l.alloc;
+            steal(copy);
+            return *this;
+        }
+        alloc = l.alloc;
+    }
+    
+    link_ptr last = nullptr;
+    link_ptr first = copy_chain(l.anchor.next, l.len, last);
+    clear();
+    if (first) {
+        link_chain_before(&anchor, first, last, l.len);
+    }
+    return *this;
+    
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::operator=(const DList<T, Alloc> & l) {
+    return assign(l);
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::assign(DList<T, Alloc> && l)
+    noexcept(node_traits::propagate_on_container_move_assignment::value or
+             node_traits::is_always_equal::value) {
+    
+    if (&l == this) {
+        return *this;
+    }
+    
+    clear();
+    if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+        alloc = l.alloc;
+    } else if (not shares_allocator(l)) {
+        return append(std::move(l));
+    }
+    steal(l);
+    return *this;
+    
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::operator=(DList<T, Alloc> && l)
+    noexcept(node_traits::propagate_on_container_move_assignment::value or
+             node_traits::is_always_equal::value) {
+    return assign(std::move(l));
+}
+
+/* The sentinels stay put, the chains are relinked to the other one */
+
+template<typename T, typename Alloc>
+void DList<T, Alloc>::swap(DList<T, Alloc> & l) noexcept {
+    
+    if constexpr (node_traits::propagate_on_container_swap::value) {
+        std::swap(alloc, l.alloc);
+    }
+    
+    link_ptr first = anchor.next;
+    link_ptr last = anchor.prev;
+    const size_t count = len;
+    
+    anchor.next = &anchor;
+    anchor.prev = &anchor;
+    len = 0;
+    steal(l);
+    
+    if (count) {
+        l.link_chain_before(&l.anchor, first, last, count);
+    }
+    
+}
+
+/* Utility functions */
+
+template<typename T, typename Alloc>
+size_t DList<T, Alloc>::size() const {
+    return len;
+}
+
+template<typename T, typename Alloc>
+template<typename Fun, typename U>
+requires std::invocable<Fun &, const T &>
+DList<U, typename std::allocator_traits<Alloc>::template rebind_alloc<U>>
+DList<T, Alloc>::map(Fun fun) const {
+    
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<U>
+        result_allocator;
+    DList<U, result_allocator> l((result_allocator(alloc)));
+    
+    for (const T & item : *this) {
+        l.push_back(std::invoke(fun, item));
+    }
+    
+    return l;
+    
+}
+
+template<typename T, typename Alloc>
+template<typename Acc, typename Fun>
+requires std::invocable<Fun &, Acc &, const T &>
+Acc DList<T, Alloc>::fold(Fun fun, Acc initVal) const {
+    
+    for (const T & item : *this) {
+        std::invoke(fun, initVal, item);
+    }
+    
+    return initVal;
+    
+}
+
+template<typename T, typename Alloc>
+template<typename Fun>
+requires std::predicate<Fun &, const T &>
+DList<T, Alloc> DList<T, Alloc>::filter(Fun fun) const {
+    
+    DList<T, Alloc> l(get_allocator());
+    
+    for (const T & item : *this) {
+        if (std::invoke(fun, item)) {
+            l.push_back(item);
+        }
+    }
+    
+    return l;
+    
+}
+
+template<typename T, typename Alloc>
+template<typename Fun>
+requires std::predicate<Fun &, const T &>
+size_t DList<T, Alloc>::remove_if(Fun fun) {
+    
+    size_t removed = 0;
+    link_ptr ptr = anchor.next;
+    
+    while (ptr != &anchor) {
+        const T & item = static_cast<node_ptr>(ptr)->item;
+        if (std::invoke(fun, item)) {
+            link_ptr next = unlink(ptr);
+            destroy_node(ptr);
+            ptr = next;
+            ++removed;
+        } else {
+            ptr = ptr->next;
+        }
+    }
+    
+    return removed;
+    
+}
+
+template<typename T, typename Alloc>
+template<typename Fun>
+requires std::predicate<Fun &, const T &>
+size_t DList<T, Alloc>::retain(Fun fun) {
+    return remove_if([&fun](const T & item) {
+        return not std::invoke(fun, item);
+    });
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc> & DList<T, Alloc>::clear() {
+    
+    if constexpr (not std::is_trivially_destructible_v<T> or
+                  not allocator_releases_in_bulk<node_allocator>::value) {
+        if (len) {
+            anchor.prev->next = nullptr;
+            destroy_chain(anchor.next);
+        }
+    }
+    
+    anchor.next = &anchor;
+    anchor.prev = &anchor;
+    len = 0;
+    
+    return *this;
+    
+}
+
+/* Constructors */
+
+template<typename T, typename Alloc>
+DList<T, Alloc>::DList() { }
+
+template<typename T, typename Alloc>
+DList<T, Alloc>::DList(const Alloc & allocator) : alloc(allocator) { }
+
+template<typename T, typename Alloc>
+DList<T, Alloc>::DList(const DList<T, Alloc> & orig)
+    : alloc(node_traits::select_on_container_copy_construction(orig.alloc)) {
+    append(orig);
+}
+
+template<typename T, typename Alloc>
+DList<T, Alloc>::DList(DList<T, Alloc> && orig) noexcept : alloc(orig.alloc) {
+    steal(orig);
+}
+
+/* Destructor */
+
+template<typename T, typename Alloc>
+DList<T, Alloc>::~DList() {
+    clear();
+}
+
+/* Swap */
+
+template<typename T, typename Alloc>
+void swap(DList<T, Alloc> & lhs, DList<T, Alloc> & rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+#endif /* dlist_hpp */
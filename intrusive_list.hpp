@@ -0,0 +1,720 @@
+//
+//  intrusive_list.hpp
+//  linked_list
+//
+//  Intrusive counterpart of List<T>. The links live in an IntrusiveHook
+//  member of the element itself, so linking never allocates or copies, and
+//  the list only strings together objects owned elsewhere (pools, arenas,
+//  the stack). A known element is unlinked in O(1).
+//
+
+#ifndef intrusive_list_hpp
+#define intrusive_list_hpp
+
+#include <cstddef>
+#include <stdexcept>
+#include <iterator>
+#include <functional>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
+
+/*************************************************************************/
+/*                                                                       */
+/* ********************************************************************* */
+/* **************************** Declaration **************************** */
+/* ********************************************************************* */
+/*                                                                       */
+/*************************************************************************/
+
+
+template <typename T>
+class IntrusiveHook;
+
+template <typename T, IntrusiveHook<T> T::*Hook>
+class IntrusiveList;
+
+/* Embedded in T, one hook per list the element can be in at the same */
+/* time. Copying T does not copy list membership                      */
+
+template <typename T>
+class IntrusiveHook {
+    
+    template<typename U, IntrusiveHook<U> U::*> friend class IntrusiveList;
+    
+    /* Traversal only follows next, prev makes unlinking O(1) */
+    
+    T * next = nullptr;
+    T * prev = nullptr;
+    
+public:
+    
+    IntrusiveHook() = default;
+    IntrusiveHook(const IntrusiveHook &) { }
+    IntrusiveHook & operator=(const IntrusiveHook &) { return *this; }
+    
+};
+
+/* The list never owns its elements. An element must stay alive while */
+/* linked and may be in only one list per hook, linking an element    */
+/* that is already linked through the same hook is undefined          */
+
+template <typename T, IntrusiveHook<T> T::*Hook>
+class IntrusiveList {
+    
+    typedef T* elem_ptr;
+    
+    size_t len = 0;
+    elem_ptr front = nullptr;
+    elem_ptr back = nullptr;
+    
+    /* Hook access */
+    
+    static IntrusiveHook<T> & hook(T & item);
+    
+    /* Element retrieval */
+    
+    elem_ptr elem_at(const size_t index) const;
+    
+    /* Utility */
+    
+    void checkIndexRange(const size_t index) const;
+    void steal(IntrusiveList<T, Hook> & l);
+    
+    /* Linking */
+    
+    void link_before(elem_ptr pos, T & item);
+    elem_ptr unlink_elem(T & item);
+    
+    /* Iterators */
+    
+    template<bool Const>
+    class Iterator {
+        
+        friend class IntrusiveList;
+        template<bool> friend class Iterator;
+        
+        elem_ptr elem = nullptr;
+        
+        explicit Iterator(elem_ptr elem);
+        
+    public:
+        
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::forward_iterator_tag iterator_concept;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::conditional_t<Const, const T, T> * pointer;
+        typedef std::conditional_t<Const, const T, T> & reference;
+        
+        Iterator() = default;
+        
+        template<bool OtherConst> requires (Const and not OtherConst)
+        Iterator(const Iterator<OtherConst> & it);
+        
+        reference operator*() const;
+        pointer operator->() const;
+        
+        Iterator & operator++();
+        Iterator operator++(int);
+        
+        bool operator==(const Iterator & other) const;
+        
+    };
+    
+public:
+    
+    typedef T value_type;
+    typedef T & reference;
+    typedef const T & const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+    
+    /* Iterators */
+    
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    
+    /* Iterator to a linked element, O(1) */
+    
+    iterator iterator_to(T & item);
+    const_iterator iterator_to(const T & item) const;
+    
+    /* Element access */
+    
+    T & at(const size_t index);
+    T & operator[](const size_t index);
+    const T & at(const size_t index) const;
+    const T & operator[](const size_t index) const;
+    
+    T & first();
+    const T & first() const;
+    
+    T & last();
+    const T & last() const;
+    
+    /* Link elements */
+    
+    IntrusiveList<T, Hook> & push_back(T & item);
+    IntrusiveList<T, Hook> & push(T & item);
+    
+    /* Same indices as List::insert: index must be < size() and item goes */
+    /* before the element at index, except that size() - 1 appends. So an */
+    /* empty list cannot be inserted into by index and nothing goes right */
+    /* before the last element, use push(), push_back() or insert(pos)    */
+    
+    IntrusiveList<T, Hook> & insert(const size_t index, T & item);
+    iterator insert(const_iterator pos, T & item);
+    
+    /* Unlink elements, the elements themselves are left untouched */
+    
+    T & pop_front();
+    T & pop_back();
+    T & remove(const size_t index);
+    IntrusiveList<T, Hook> & unlink(T & item);
+    iterator erase(const_iterator pos);
+    
+    /* Moves every element of l to the end of this list, O(1) */
+    
+    IntrusiveList<T, Hook> & append(IntrusiveList<T, Hook> && l);
+    IntrusiveList<T, Hook> & operator+=(IntrusiveList<T, Hook> && l);
+    
+    /* Assignment */
+    
+    IntrusiveList<T, Hook> & operator=(const IntrusiveList<T, Hook> &) = delete;
+    IntrusiveList<T, Hook> & operator=(IntrusiveList<T, Hook> && l);
+    
+    /* Utility */
+    
+    size_t size() const;
+    bool empty() const;
+    
+    template<typename Fun>
+    requires std::predicate<Fun &, const T &>
+    size_t remove_if(Fun fun);
+    
+    IntrusiveList<T, Hook> & clear();
+    
+    /* Constructors */
+    
+    IntrusiveList();
+    IntrusiveList(const IntrusiveList<T, Hook> &) = delete;
+    IntrusiveList(IntrusiveList<T, Hook> && orig);
+    
+    /* Destructor, unlinks every element */
+    
+    ~IntrusiveList();
+    
+};
+
+/**************************************************************************/
+/*                                                                        */
+/* ********************************************************************** */
+/* *************************** Implementation *************************** */
+/* ********************************************************************** */
+/*                                                                        */
+/**************************************************************************/
+
+
+/********************************************************************/
+/*                                                                  */
+/*                             Iterator                             */
+/*                                                                  */
+/********************************************************************/
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+template<bool Const>
+IntrusiveList<T, Hook>::Iterator<Const>::Iterator(elem_ptr elem)
+    : elem(elem) { }
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+template<bool Const>
+template<bool OtherConst> requires (Const and not OtherConst)
+IntrusiveList<T, Hook>::Iterator<Const>::Iterator(
+    const Iterator<OtherConst> & it) : elem(it.elem) { }
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+template<bool Const>
+typename IntrusiveList<T, Hook>::template Iterator<Const>::reference
+IntrusiveList<T, Hook>::Iterator<Const>::operator*() const {
+    return *elem;
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+template<bool Const>
+typename IntrusiveList<T, Hook>::template Iterator<Const>::pointer
+IntrusiveList<T, Hook>::Iterator<Const>::operator->() const {
+    return elem;
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+template<bool Const>
+typename IntrusiveList<T, Hook>::template Iterator<Const> &
+IntrusiveList<T, Hook>::Iterator<Const>::operator++() {
+    elem = hook(*elem).next;
+    return *this;
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+template<bool Const>
+typename IntrusiveList<T, Hook>::template Iterator<Const>
+IntrusiveList<T, Hook>::Iterator<Const>::operator++(int) {
+    Iterator copy = *this;
+    elem = hook(*elem).next;
+    return copy;
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+template<bool Const>
+bool IntrusiveList<T, Hook>::Iterator<Const>::operator==(
+    const Iterator & other) const {
+    return elem == other.elem;
+}
+
+
+/*********************************************************************/
+/*                                                                   */
+/*                       IntrusiveList<T, Hook>                      */
+/*                                                                   */
+/*********************************************************************/
+
+/**********************/
+/*      Internal      */
+/**********************/
+
+/* Hook access */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+IntrusiveHook<T> & IntrusiveList<T, Hook>::hook(T & item) {
+    return item.*Hook;
+}
+
+/* Element retrieval */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::elem_ptr
+IntrusiveList<T, Hook>::elem_at(const size_t index) const {
+    
+    if (index == len - 1) {
+        return back;
+    }
+    
+    elem_ptr ptr = front;
+    for (size_t i = 0; i < index; ++i) {
+        ptr = hook(*ptr).next;
+    }
+    return ptr;
+    
+}
+
+/* Utility */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+void IntrusiveList<T, Hook>::checkIndexRange(const size_t index) const {
+    if (index >= len) {
+        throw std::out_of_range("IntrusiveList index out of range.");
+    }
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+void IntrusiveList<T, Hook>::steal(IntrusiveList<T, Hook> & l) {
+    
+    front = l.front;
+    back = l.back;
+    len = l.len;
+    
+    l.front = nullptr;
+    l.back = nullptr;
+    l.len = 0;
+    
+}
+
+/* Linking */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+void IntrusiveList<T, Hook>::link_before(elem_ptr pos, T & item) {
+    
+    /* pos == nullptr links item at the end */
+    
+    elem_ptr prev = pos == nullptr ? back : hook(*pos).prev;
+    
+    hook(item).next = pos;
+    hook(item).prev = prev;
+    
+    if (prev == nullptr) {
+        front = &item;
+    } else {
+        hook(*prev).next = &item;
+    }
+    
+    if (pos == nullptr) {
+        back = &item;
+    } else {
+        hook(*pos).prev = &item;
+    }
+    
+    ++len;
+    
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::elem_ptr
+IntrusiveList<T, Hook>::unlink_elem(T & item) {
+    
+    elem_ptr next = hook(item).next;
+    elem_ptr prev = hook(item).prev;
+    
+    if (prev == nullptr) {
+        front = next;
+    } else {
+        hook(*prev).next = next;
+    }
+    
+    if (next == nullptr) {
+        back = prev;
+    } else {
+        hook(*next).prev = prev;
+    }
+    
+    hook(item).next = nullptr;
+    hook(item).prev = nullptr;
+    --len;
+    
+    return next;
+    
+}
+
+/**********************/
+/*       Public       */
+/**********************/
+
+/* Iterators */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::begin() {
+    return iterator(front);
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::iterator IntrusiveList<T, Hook>::end() {
+    return iterator(nullptr);
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator
+IntrusiveList<T, Hook>::begin() const {
+    return const_iterator(front);
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator
+IntrusiveList<T, Hook>::end() const {
+    return const_iterator(nullptr);
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator
+IntrusiveList<T, Hook>::cbegin() const {
+    return begin();
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator
+IntrusiveList<T, Hook>::cend() const {
+    return end();
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::iterator
+IntrusiveList<T, Hook>::iterator_to(T & item) {
+    return iterator(&item);
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::const_iterator
+IntrusiveList<T, Hook>::iterator_to(const T & item) const {
+    return const_iterator(const_cast<elem_ptr>(&item));
+}
+
+/* Element access */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+T & IntrusiveList<T, Hook>::at(const size_t index) {
+    checkIndexRange(index);
+    return *elem_at(index);
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+T & IntrusiveList<T, Hook>::operator[](const size_t index) {
+    return at(index);
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+const T & IntrusiveList<T, Hook>::at(const size_t index) const {
+    checkIndexRange(index);
+    return *elem_at(index);
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+const T & IntrusiveList<T, Hook>::operator[](const size_t index) const {
+    return at(index);
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+T & IntrusiveList<T, Hook>::first() {
+    
+    if (front == nullptr) {
+        throw std::out_of_range("Calling IntrusiveList<T>::first() on an empty "
+                                "IntrusiveList");
+    }
+    
+    return *front;
+    
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+const T & IntrusiveList<T, Hook>::first() const {
+    
+    if (front == nullptr) {
+        throw std::out_of_range("Calling IntrusiveList<T>::first() on an empty "
+                                "IntrusiveList");
+    }
+    
+    return *front;
+    
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+T & IntrusiveList<T, Hook>::last() {
+    
+    if (back == nullptr) {
+        throw std::out_of_range("Calling IntrusiveList<T>::last() on an empty "
+                                "IntrusiveList");
+    }
+    
+    return *back;
+    
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+const T & IntrusiveList<T, Hook>::last() const {
+    
+    if (back == nullptr) {
+        throw std::out_of_range("Calling IntrusiveList<T>::last() on an empty "
+                                "IntrusiveList");
+    }
+    
+    return *back;
+    
+}
+
+/* Link elements */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook> & IntrusiveList<T, Hook>::push_back(T & item) {
+    link_before(nullptr, item);
+    return *this;
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook> & IntrusiveList<T, Hook>::push(T & item) {
+    link_before(front, item);
+    return *this;
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook> &
+IntrusiveList<T, Hook>::insert(const size_t index, T & item) {
+    
+    if (index >= len) {
+        throw std::out_of_range("IntrusiveList index out of range.");
+    }
+    
+    link_before(index == len - 1 ? nullptr : elem_at(index), item);
+    return *this;
+    
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::iterator
+IntrusiveList<T, Hook>::insert(const_iterator pos, T & item) {
+    link_before(pos.elem, item);
+    return iterator(&item);
+}
+
+/* Unlink elements */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+T & IntrusiveList<T, Hook>::pop_front() {
+    
+    if (front == nullptr) {
+        throw std::runtime_error("");
+    }
+    
+    T & item = *front;
+    unlink_elem(item);
+    return item;
+    
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+T & IntrusiveList<T, Hook>::pop_back() {
+    
+    if (back == nullptr) {
+        throw std::runtime_error("");
+    }
+    
+    T & item = *back;
+    unlink_elem(item);
+    return item;
+    
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+T & IntrusiveList<T, Hook>::remove(const size_t index) {
+    
+    checkIndexRange(index);
+    
+    T & item = *elem_at(index);
+    unlink_elem(item);
+    return item;
+    
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook> & IntrusiveList<T, Hook>::unlink(T & item) {
+    unlink_elem(item);
+    return *this;
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+typename IntrusiveList<T, Hook>::iterator
+IntrusiveList<T, Hook>::erase(const_iterator pos) {
+    return iterator(unlink_elem(*pos.elem));
+}
+
+/* Append list */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook> &
+IntrusiveList<T, Hook>::append(IntrusiveList<T, Hook> && l) {
+    
+    if (&l == this or l.len == 0) {
+        return *this;
+    }
+    if (len == 0) {
+        steal(l);
+        return *this;
+    }
+    
+    hook(*back).next = l.front;
+    hook(*l.front).prev = back;
+    back = l.back;
+    len += l.len;
+    
+    l.front = nullptr;
+    l.back = nullptr;
+    l.len = 0;
+    
+    return *this;
+    
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook> &
+IntrusiveList<T, Hook>::operator+=(IntrusiveList<T, Hook> && l) {
+    return append(std::move(l));
+}
+
+/* Assignment */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook> &
+IntrusiveList<T, Hook>::operator=(IntrusiveList<T, Hook> && l) {
+    
+    if (&l != this) {
+        clear();
+        steal(l);
+    }
+    return *this;
+    
+}
+
+/* Utility */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+size_t IntrusiveList<T, Hook>::size() const {
+    return len;
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+bool IntrusiveList<T, Hook>::empty() const {
+    return len == 0;
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+template<typename Fun>
+requires std::predicate<Fun &, const T &>
+size_t IntrusiveList<T, Hook>::remove_if(Fun fun) {
+    
+    size_t removed = 0;
+    
+    for (elem_ptr ptr = front; ptr != nullptr; ) {
+        elem_ptr next = hook(*ptr).next;
+        if (std::invoke(fun, std::as_const(*ptr))) {
+            unlink_elem(*ptr);
+            ++removed;
+        }
+        ptr = next;
+    }
+    
+    return removed;
+    
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook> & IntrusiveList<T, Hook>::clear() {
+    
+    /* Reset every hook, so the elements can be linked again */
+    
+    elem_ptr ptr = front;
+    while (ptr != nullptr) {
+        elem_ptr next = hook(*ptr).next;
+        hook(*ptr).next = nullptr;
+        hook(*ptr).prev = nullptr;
+        ptr = next;
+    }
+    
+    front = nullptr;
+    back = nullptr;
+    len = 0;
+    
+    return *this;
+    
+}
+
+/* Constructors */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook>::IntrusiveList() { }
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook>::IntrusiveList(IntrusiveList<T, Hook> && orig) {
+    steal(orig);
+}
+
+/* Destructor */
+
+template<typename T, IntrusiveHook<T> T::*Hook>
+IntrusiveList<T, Hook>::~IntrusiveList() {
+    clear();
+}
+
+#endif /* intrusive_list_hpp */
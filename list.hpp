@@ -15,6 +15,23 @@
 #include <stdexcept>
 #include <iterator>
 #include <functional>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+#include "list_stats.hpp"
+
+/* Compiled with -DLINKED_LIST_PREFETCH, loops that do work per node    */
+/* (copying, map, fold, filter, clear) prefetch the next node first, so */
+/* its cache miss overlaps with that work instead of following it       */
+
+#if defined(LINKED_LIST_PREFETCH) and (defined(__GNUC__) or defined(__clang__))
+#define LIST_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+#define LIST_PREFETCH(ptr) ((void)0)
+#endif
 
 
 /*************************************************************************/
@@ -26,41 +43,101 @@
 /*************************************************************************/
 
 
-template <typename T>
+/* Allocators whose deallocate() is a no-op (memory is released by the     */
+/* owner of the arena) specialize this to let clear() skip the node walk  */
+/* for trivially destructible items                                       */
+
+template<typename Alloc>
+struct allocator_releases_in_bulk : std::false_type { };
+
+/* Allocators that keep node storage inside the allocator object, and so */
+/* inside the List, specialize this. Their nodes cannot change owners,   */
+/* so moving or swapping such a List moves the items instead of nodes    */
+
+template<typename Alloc>
+struct allocator_stores_nodes_inline : std::false_type { };
+
+/* Binary loading in list_io.hpp links nodes directly */
+
+struct ListBinaryIO;
+
+template <typename T, typename Alloc = std::allocator<T>>
 class List {
     
-    struct Node {
+    struct Node;
+    
+    /* head is a Link rather than a Node, so &head can serve as the */
+    /* position before the first node for the *_after operations  */
+    
+    struct Link {
         
-        Node * next;
-        T item;
+        Node * next = nullptr;
         
-        template<typename... args>
-        Node(args&... a);
+    };
+    
+    struct Node : Link {
         
-        template<typename... args>
-        Node(args&&... a);
+        T item;
         
         template<typename... args>
-        Node(const args&... a);
+        Node(std::in_place_t, args&&... a);
         
-        Node(const Node & node);
-        Node(Node & node);
-        Node(Node && node);
+        Node(const Node & node) = delete;
+        Node & operator=(const Node & node) = delete;
         
     };
     
+    typedef Link* link_ptr;
     typedef Node* node_ptr;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Node>
+        node_allocator;
+    typedef std::allocator_traits<node_allocator> node_traits;
+    
+    template<typename, typename> friend class List;
+    friend struct ListBinaryIO;
     
     size_t len = 0;
-    node_ptr head = nullptr;
+    Link head;
     node_ptr back = nullptr;
+    [[no_unique_address]] node_allocator alloc;
+    
+    /* Last node found by node_at(), so ascending index loops resume from  */
+    /* it instead of head. Updated by const accessors, so concurrent reads */
+    /* of the same List need external synchronization                      */
+    
+    mutable size_t cursor_index = 0;
+    mutable node_ptr cursor_node = nullptr;
+    
+    /* Node allocation */
+    
+    template<typename... args>
+    node_ptr create_node(args&&... a);
+    void destroy_node(node_ptr node);
+    bool shares_allocator(const List<T, Alloc> & l) const;
+    
+    /* Chain copying, copy_chain() frees its partial copy if T throws */
+    
+    node_ptr copy_chain(node_ptr first, const size_t count, node_ptr & last);
+    void destroy_chain(node_ptr first);
+    void steal(List<T, Alloc> & l);
+    
+    /* Merging, merge_chains() leaves every node linked after into even */
+    /* if comp throws                                                   */
+    
+    template<typename Compare>
+    static node_ptr merge_chains(link_ptr into,
+                                 node_ptr a,
+                                 node_ptr b,
+                                 Compare & comp);
+    static node_ptr cut_after(node_ptr first, const size_t count);
+    static node_ptr last_of(link_ptr first);
     
     /* Node retreival */
     
     // node_ptr & find_last_ptr();
     // node_ptr find_last_node();
-    node_ptr node_at(const size_t index);
-    const node_ptr node_at(const size_t index) const;
+    node_ptr node_at(const size_t index) const;
+    void reset_cursor() const;
     
     /* Utility */
     
@@ -68,12 +145,76 @@ class List {
     
     /* Node insertion */
     
-    List<T> & push_back_node(node_ptr node);
-    List<T> & push_node(node_ptr node);
-    List<T> & insert_node(const size_t index, node_ptr node);
+    List<T, Alloc> & push_back_node(node_ptr node);
+    List<T, Alloc> & push_node(node_ptr node);
+    List<T, Alloc> & insert_node(const size_t index, node_ptr node);
+    node_ptr link_after(link_ptr pos, node_ptr node);
+    node_ptr unlink_after(link_ptr pos);
+    
+    /* Iterators */
+    
+    template<bool Const>
+    class Iterator {
+        
+        friend class List;
+        template<bool> friend class Iterator;
+        
+        link_ptr node = nullptr;
+        
+        explicit Iterator(link_ptr node);
+        
+    public:
+        
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::forward_iterator_tag iterator_concept;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::conditional_t<Const, const T, T> * pointer;
+        typedef std::conditional_t<Const, const T, T> & reference;
+        
+        Iterator() = default;
+        
+        template<bool OtherConst> requires (Const and not OtherConst)
+        Iterator(const Iterator<OtherConst> & it);
+        
+        reference operator*() const;
+        pointer operator->() const;
+        
+        Iterator & operator++();
+        Iterator operator++(int);
+        
+        bool operator==(const Iterator & other) const;
+        
+    };
     
 public:
     
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef T & reference;
+    typedef const T & const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+    
+    /* Allocator */
+    
+    allocator_type get_allocator() const;
+    
+    /* Iterators */
+    
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    
+    iterator before_begin();
+    const_iterator before_begin() const;
+    const_iterator cbefore_begin() const;
+    
     /* Element access */
     
     T & at(const size_t index);
@@ -89,48 +230,39 @@ public:
     
     /* Push back */
     
-    List<T> & push_back(const T & item);
-    List<T> & push_back(T & item);
-    List<T> & push_back(T && item);
-
-    template<typename... args>
-    List<T> & push_back(args&... a);
+    List<T, Alloc> & push_back(const T & item);
+    List<T, Alloc> & push_back(T && item);
     
     template<typename... args>
-    List<T> & push_back(args&&... a);
+    requires std::constructible_from<T, args&&...>
+    List<T, Alloc> & push_back(args&&... a);
     
     template<typename... args>
-    List<T> & push_back(const args&... a);
+    T & emplace_back(args&&... a);
     
     /* Push front */
     
-    List<T> & push(const T & item);
-    List<T> & push(T & item);
-    List<T> & push(T && item);
-    
-    template<typename... args>
-    List<T> & push(args&... a);
+    List<T, Alloc> & push(const T & item);
+    List<T, Alloc> & push(T && item);
     
     template<typename... args>
-    List<T> & push(args&&... a);
+    requires std::constructible_from<T, args&&...>
+    List<T, Alloc> & push(args&&... a);
     
     template<typename... args>
-    List<T> & push(const args&... a);
+    T & emplace_front(args&&... a);
     
     /* Insert at index */
     
-    List<T> & insert(const size_t index, const T & item);
-    List<T> & insert(const size_t index, T & item);
-    List<T> & insert(const size_t index, T && item);
+    List<T, Alloc> & insert(const size_t index, const T & item);
+    List<T, Alloc> & insert(const size_t index, T && item);
     
     template<typename... args>
-    List<T> & insert(const size_t index, args&... a);
+    requires std::constructible_from<T, args&&...>
+    List<T, Alloc> & insert(const size_t index, args&&... a);
     
     template<typename... args>
-    List<T> & insert(const size_t index, args&&... a);
-    
-    template<typename... args>
-    List<T> & insert(const size_t index, const args&... a);
+    T & emplace(const size_t index, args&&... a);
     
     /* Remove elements */
     
@@ -138,52 +270,120 @@ public:
     T pop_back();
     T remove(const size_t index);
     
+    /* Insert, remove and splice after iterator, O(1) given the position */
+    
+    iterator insert_after(const_iterator pos, const T & item);
+    iterator insert_after(const_iterator pos, T && item);
+    
+    template<typename... args>
+    iterator emplace_after(const_iterator pos, args&&... a);
+    
+    iterator erase_after(const_iterator pos);
+    iterator erase_after(const_iterator first, const_iterator last);
+    
+    void splice_after(const_iterator pos, List<T, Alloc> && l);
+    void splice_after(const_iterator pos, List<T, Alloc> && l,
+                      const_iterator it);
+    void splice_after(const_iterator pos, List<T, Alloc> && l,
+                      const_iterator first, const_iterator last);
+    
     /* List concatenation */
     
-    List<T> concatenate(const List<T> & l) const;
-    List<T> operator+(const List<T> & l) const;
-    List<T> concatenate(List<T> && l) const;
-    List<T> operator+(List<T> && l) const;
+    List<T, Alloc> concatenate(const List<T, Alloc> & l) const;
+    List<T, Alloc> operator+(const List<T, Alloc> & l) const;
+    List<T, Alloc> concatenate(List<T, Alloc> && l) const;
+    List<T, Alloc> operator+(List<T, Alloc> && l) const;
     
     /* Append list */
     
-    List<T> & append(const List<T> & l);
-    List<T> & operator+=(const List<T> & l);
-    List<T> & append(List<T> && l);
-    List<T> & operator+=(List<T> && l);
+    List<T, Alloc> & append(const List<T, Alloc> & l);
+    List<T, Alloc> & operator+=(const List<T, Alloc> & l);
+    List<T, Alloc> & append(List<T, Alloc> && l);
+    List<T, Alloc> & operator+=(List<T, Alloc> && l);
     
     /* Assignment */
     
-    List<T> & assign(const List<T> & l);
-    List<T> & operator=(const List<T> & l);
-    List<T> & assign(List<T> && l);
-    List<T> & operator=(List<T> && l);
+    List<T, Alloc> & assign(const List<T, Alloc> & l);
+    List<T, Alloc> & operator=(const List<T, Alloc> & l);
+    List<T, Alloc> & assign(List<T, Alloc> && l)
+        noexcept(node_traits::propagate_on_container_move_assignment::value or
+                 node_traits::is_always_equal::value);
+    List<T, Alloc> & operator=(List<T, Alloc> && l)
+        noexcept(node_traits::propagate_on_container_move_assignment::value or
+                 node_traits::is_always_equal::value);
+    
+    void swap(List<T, Alloc> & l)
+        noexcept(not allocator_stores_nodes_inline<Alloc>::value);
     
     /* Utility */
     
     size_t size() const;
     
-    List<T> map(std::function<T(const T&)> fun) const;
+    template<typename Fun,
+             typename U = std::remove_cvref_t<
+                 std::invoke_result_t<Fun &, const T &>>>
+    requires std::invocable<Fun &, const T &>
+    List<U, typename std::allocator_traits<Alloc>::template rebind_alloc<U>>
+    map(Fun fun) const;
+    
+    template<typename Acc, typename Fun>
+    requires std::invocable<Fun &, Acc &, const T &>
+    Acc fold(Fun fun, Acc initVal) const;
+    
+    template<typename Fun>
+    requires std::predicate<Fun &, const T &>
+    List<T, Alloc> filter(Fun fun) const;
+    
+    template<typename Fun>
+    requires std::predicate<Fun &, const T &>
+    size_t remove_if(Fun fun);
+    
+    template<typename Fun>
+    requires std::predicate<Fun &, const T &>
+    size_t retain(Fun fun);
     
-    template<typename Acc>
-    Acc fold(std::function<void(Acc & acc, const T&)> fun, Acc initVal) const;
+    /* Ordering, done by relinking nodes, no items are moved or allocated */
     
-    List<T> filter(std::function<bool(const T&)> fun) const;
+    List<T, Alloc> & sort();
     
-    List<T> & clear();
+    template<typename Compare>
+    requires std::strict_weak_order<Compare &, const T &, const T &>
+    List<T, Alloc> & sort(Compare comp);
+    
+    List<T, Alloc> & merge(List<T, Alloc> && l);
+    
+    template<typename Compare>
+    requires std::strict_weak_order<Compare &, const T &, const T &>
+    List<T, Alloc> & merge(List<T, Alloc> && l, Compare comp);
+    
+    size_t unique();
+    
+    template<typename Fun>
+    requires std::predicate<Fun &, const T &, const T &>
+    size_t unique(Fun fun);
+    
+    List<T, Alloc> & reverse();
+    
+    List<T, Alloc> & clear();
     
     /* Constructors */
     
-    List<T>();
-    List<T>(const List<T> & orig);
-    List<T>(List<T> && orig);
+    List();
+    explicit List(const Alloc & allocator);
+    List(const List<T, Alloc> & orig);
+    List(List<T, Alloc> && orig)
+        noexcept(not allocator_stores_nodes_inline<Alloc>::value);
     
     /* Destructor */
     
-    ~List<T>();
+    ~List();
     
 };
 
+template<typename T, typename Alloc>
+void swap(List<T, Alloc> & lhs, List<T, Alloc> & rhs)
+    noexcept(not allocator_stores_nodes_inline<Alloc>::value);
+
 /**************************************************************************/
 /*                                                                        */
 /* ********************************************************************** */
@@ -201,26 +401,64 @@ public:
 
 /* Node constructors */
 
-template<typename T>
+template<typename T, typename Alloc>
 template <typename... args>
-List<T>::Node::Node(args&... a) : item(a...) { }
+List<T, Alloc>::Node::Node(std::in_place_t, args&&... a)
+    : item(std::forward<args>(a)...) { }
 
-template<typename T>
-template <typename... args>
-List<T>::Node::Node(args&&... a) : item(a...) { }
 
-template<typename T>
-template <typename... args>
-List<T>::Node::Node(const args&... a) : item(a...) { }
+/********************************************************************/
+/*                                                                  */
+/*                             Iterator                             */
+/*                                                                  */
+/********************************************************************/
 
-template<typename T>
-List<T>::Node::Node(const Node & node) : item(node.item) { }
+template<typename T, typename Alloc>
+template<bool Const>
+List<T, Alloc>::Iterator<Const>::Iterator(link_ptr node) : node(node) { }
+
+template<typename T, typename Alloc>
+template<bool Const>
+template<bool OtherConst> requires (Const and not OtherConst)
+List<T, Alloc>::Iterator<Const>::Iterator(const Iterator<OtherConst> & it)
+    : node(it.node) { }
+
+template<typename T, typename Alloc>
+template<bool Const>
+typename List<T, Alloc>::template Iterator<Const>::reference
+List<T, Alloc>::Iterator<Const>::operator*() const {
+    return static_cast<node_ptr>(node)->item;
+}
 
-template<typename T>
-List<T>::Node::Node(Node & node) : item(node.item) { }
+template<typename T, typename Alloc>
+template<bool Const>
+typename List<T, Alloc>::template Iterator<Const>::pointer
+List<T, Alloc>::Iterator<Const>::operator->() const {
+    return &static_cast<node_ptr>(node)->item;
+}
 
-template<typename T>
-List<T>::Node::Node(Node && node) : item(node.item) { }
+template<typename T, typename Alloc>
+template<bool Const>
+typename List<T, Alloc>::template Iterator<Const> &
+List<T, Alloc>::Iterator<Const>::operator++() {
+    node = node->next;
+    return *this;
+}
+
+template<typename T, typename Alloc>
+template<bool Const>
+typename List<T, Alloc>::template Iterator<Const>
+List<T, Alloc>::Iterator<Const>::operator++(int) {
+    Iterator copy = *this;
+    node = node->next;
+    return copy;
+}
+
+template<typename T, typename Alloc>
+template<bool Const>
+bool List<T, Alloc>::Iterator<Const>::operator==(const Iterator & other) const {
+    return node == other.node;
+}
 
 
 /*********************************************************************/
@@ -233,12 +471,160 @@ List<T>::Node::Node(Node && node) : item(node.item) { }
 /*      Internal      */
 /**********************/
 
+/* Node allocation */
+
+template<typename T, typename Alloc>
+template<typename... args>
+typename List<T, Alloc>::node_ptr List<T, Alloc>::create_node(args&&... a) {
+    
+    node_ptr node = node_traits::allocate(alloc, 1);
+    try {
+        node_traits::construct(alloc, node, std::in_place,
+                              std::forward<args>(a)...);
+    } catch (...) {
+        node_traits::deallocate(alloc, node, 1);
+        throw;
+    }
+    LIST_STATS(allocated(1));
+    return node;
+    
+}
+
+template<typename T, typename Alloc>
+void List<T, Alloc>::destroy_node(node_ptr node) {
+    node_traits::destroy(alloc, node);
+    node_traits::deallocate(alloc, node, 1);
+    LIST_STATS(freed(1));
+}
+
+template<typename T, typename Alloc>
+bool List<T, Alloc>::shares_allocator(const List<T, Alloc> & l) const {
+    if constexpr (node_traits::is_always_equal::value) {
+        return true;
+    } else {
+        return alloc == l.alloc;
+    }
+}
+
+/* Chain copying */
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::node_ptr
+List<T, Alloc>::copy_chain(node_ptr first, const size_t count, node_ptr & last) {
+    
+    node_ptr copy = nullptr;
+    last = nullptr;
+    
+    try {
+        for (size_t i = 0; i < count; ++i, first = first->next) {
+            LIST_PREFETCH(first->next);
+            node_ptr node = create_node(first->item);
+            if (last) {
+                last->next = node;
+            } else {
+                copy = node;
+            }
+            last = node;
+        }
+    } catch (...) {
+        destroy_chain(copy);
+        throw;
+    }
+    
+    return copy;
+    
+}
+
+template<typename T, typename Alloc>
+void List<T, Alloc>::destroy_chain(node_ptr first) {
+    while (first != nullptr) {
+        node_ptr next = first->next;
+        LIST_PREFETCH(next);
+        destroy_node(first);
+        first = next;
+    }
+}
+
+template<typename T, typename Alloc>
+void List<T, Alloc>::steal(List<T, Alloc> & l) {
+    head.next = l.head.next;
+    back = l.back;
+    len = l.len;
+    LIST_STATS(length(len));
+    l.head.next = nullptr;
+    l.back = nullptr;
+    l.len = 0;
+    reset_cursor();
+    l.reset_cursor();
+}
+
+/* Merging */
+
+template<typename T, typename Alloc>
+template<typename Compare>
+typename List<T, Alloc>::node_ptr
+List<T, Alloc>::merge_chains(link_ptr into, node_ptr a, node_ptr b, Compare & comp) {
+    
+    link_ptr tail = into;
+    
+    try {
+        while (a != nullptr and b != nullptr) {
+            /* Ties take from a, which keeps the merge stable */
+            if (std::invoke(comp, b->item, a->item)) {
+                tail->next = b;
+                b = b->next;
+            } else {
+                tail->next = a;
+                a = a->next;
+            }
+            tail = tail->next;
+        }
+    } catch (...) {
+        tail->next = a;
+        last_of(tail)->next = b;
+        throw;
+    }
+    
+    tail->next = a ? a : b;
+    return last_of(tail);
+    
+}
+
+/* Cuts the chain after count nodes, returns the rest */
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::node_ptr
+List<T, Alloc>::cut_after(node_ptr first, const size_t count) {
+    
+    for (size_t i = 1; i < count and first != nullptr; ++i) {
+        first = first->next;
+    }
+    if (first == nullptr) {
+        return nullptr;
+    }
+    
+    node_ptr rest = first->next;
+    first->next = nullptr;
+    return rest;
+    
+}
+
+/* Last node after first, or first itself, which then must not be &head */
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::node_ptr List<T, Alloc>::last_of(link_ptr first) {
+    while (first->next != nullptr) {
+        first = first->next;
+    }
+    return static_cast<node_ptr>(first);
+}
+
 /* Node retrieval */
 
 /*
 
-template<typename T>
-typename List<T>::node_ptr & List<T>::find_last_ptr() {
+template<typename T, typename Alloc>
+typename List<T, Alloc>::node_ptr & List<T, Alloc>::find_last_ptr() {
     
     node_ptr ptr = find_last_node();
     if (ptr == nullptr) {
@@ -248,8 +634,8 @@ typename List<T>::node_ptr & List<T>::find_last_ptr() {
     
 }
 
-template<typename T>
-typename List<T>::node_ptr List<T>::find_last_node() {
+template<typename T, typename Alloc>
+typename List<T, Alloc>::node_ptr List<T, Alloc>::find_last_node() {
     
     if (head == nullptr) {
         return nullptr;
@@ -263,32 +649,41 @@ typename List<T>::node_ptr List<T>::find_last_node() {
  
  */
 
-template<typename T>
-typename List<T>::node_ptr List<T>::node_at(const size_t index) {
+template<typename T, typename Alloc>
+typename List<T, Alloc>::node_ptr List<T, Alloc>::node_at(const size_t index) const {
     
-    node_ptr ptr = head;
-    for (size_t i = 0; i < index; ++i) {
-        ptr = ptr->next;
+    if (index == len - 1) {
+        LIST_STATS(node_at(0));
+        return back;
     }
-    return ptr;
     
-}
-
-template<typename T>
-const typename List<T>::node_ptr List<T>::node_at(const size_t index) const {
+    node_ptr ptr = head.next;
+    size_t i = 0;
+    if (cursor_node != nullptr and cursor_index <= index) {
+        ptr = cursor_node;
+        i = cursor_index;
+    }
+    LIST_STATS(node_at(index - i));
     
-    node_ptr ptr = head;
-    for (size_t i = 0; i < index; ++i) {
+    for (; i < index; ++i) {
         ptr = ptr->next;
     }
+    
+    cursor_index = index;
+    cursor_node = ptr;
     return ptr;
     
 }
 
+template<typename T, typename Alloc>
+void List<T, Alloc>::reset_cursor() const {
+    cursor_node = nullptr;
+}
+
 /* Utility */
 
-template<typename T>
-void List<T>::checkIndexRange(const size_t index) const {
+template<typename T, typename Alloc>
+void List<T, Alloc>::checkIndexRange(const size_t index) const {
     if (index >= len) {
         throw std::out_of_range("List index out of range.");
     }
@@ -296,33 +691,36 @@ void List<T>::checkIndexRange(const size_t index) const {
 
 /* Node insertion */
 
-template<typename T>
-List<T> & List<T>::push_back_node(node_ptr node) {
-    if (head == nullptr) {
-        head = node;
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::push_back_node(node_ptr node) {
+    if (head.next == nullptr) {
+        head.next = node;
     }
     if (back) {
         back->next = node;
     }
     back = node;
     ++len;
+    LIST_STATS(length(len));
     return *this;
 }
 
-template<typename T>
-List<T> & List<T>::push_node(node_ptr node) {
-    node_ptr first = head;
-    if (head == nullptr) {
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::push_node(node_ptr node) {
+    reset_cursor();
+    node_ptr first = head.next;
+    if (head.next == nullptr) {
         back = node;
     }
-    head = node;
-    head->next = first;
+    head.next = node;
+    head.next->next = first;
     ++len;
+    LIST_STATS(length(len));
     return *this;
 }
 
-template<typename T>
-List<T> & List<T>::insert_node(const size_t index, node_ptr node) {
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::insert_node(const size_t index, node_ptr node) {
     
     checkIndexRange(index);
     if (index == len - 1) {
@@ -337,62 +735,146 @@ List<T> & List<T>::insert_node(const size_t index, node_ptr node) {
     ptr->next = node;
     ptr->next->next = next;
     ++len;
+    LIST_STATS(length(len));
+    reset_cursor();
     return *this;
     
 }
 
+template<typename T, typename Alloc>
+typename List<T, Alloc>::node_ptr
+List<T, Alloc>::link_after(link_ptr pos, node_ptr node) {
+    reset_cursor();
+    if (pos->next == nullptr) {
+        back = node;
+    }
+    node->next = pos->next;
+    pos->next = node;
+    ++len;
+    LIST_STATS(length(len));
+    return node;
+}
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::node_ptr List<T, Alloc>::unlink_after(link_ptr pos) {
+    reset_cursor();
+    node_ptr node = pos->next;
+    pos->next = node->next;
+    if (node == back) {
+        back = pos == &head ? nullptr : static_cast<node_ptr>(pos);
+    }
+    --len;
+    return node;
+}
+
 /**********************/
 /*       Public       */
 /**********************/
 
+/* Allocator */
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::allocator_type List<T, Alloc>::get_allocator() const {
+    return allocator_type(alloc);
+}
+
+/* Iterators */
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::iterator List<T, Alloc>::begin() {
+    return iterator(head.next);
+}
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::iterator List<T, Alloc>::end() {
+    return iterator(nullptr);
+}
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator List<T, Alloc>::begin() const {
+    return const_iterator(head.next);
+}
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator List<T, Alloc>::end() const {
+    return const_iterator(nullptr);
+}
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator List<T, Alloc>::cbegin() const {
+    return begin();
+}
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator List<T, Alloc>::cend() const {
+    return end();
+}
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::iterator List<T, Alloc>::before_begin() {
+    return iterator(&head);
+}
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator List<T, Alloc>::before_begin() const {
+    return const_iterator(const_cast<link_ptr>(&head));
+}
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::const_iterator List<T, Alloc>::cbefore_begin() const {
+    return before_begin();
+}
+
 /* Element access */
 
-template<typename T>
-T & List<T>::at(const size_t index) {
+template<typename T, typename Alloc>
+T & List<T, Alloc>::at(const size_t index) {
+    LIST_STATS(call(ListOp::at));
     checkIndexRange(index);
     return node_at(index)->item;
 }
 
-template<typename T>
-T & List<T>::operator[](const size_t index) {
+template<typename T, typename Alloc>
+T & List<T, Alloc>::operator[](const size_t index) {
     return at(index);
 }
 
-template<typename T>
-const T & List<T>::at(const size_t index) const {
+template<typename T, typename Alloc>
+const T & List<T, Alloc>::at(const size_t index) const {
+    LIST_STATS(call(ListOp::at));
     checkIndexRange(index);
     return node_at(index)->item;
 }
 
-template<typename T>
-const T & List<T>::operator[](const size_t index) const {
+template<typename T, typename Alloc>
+const T & List<T, Alloc>::operator[](const size_t index) const {
     return at(index);
 }
 
-template<typename T>
-T & List<T>::first() {
+template<typename T, typename Alloc>
+T & List<T, Alloc>::first() {
     
-    if (head == nullptr) {
+    if (head.next == nullptr) {
         throw std::out_of_range("Calling List<T>::first() on an empty List");
     }
     
-    return head->item;
+    return head.next->item;
     
 }
 
-template<typename T>
-const T & List<T>::first() const {
+template<typename T, typename Alloc>
+const T & List<T, Alloc>::first() const {
     
-    if (head == nullptr) {
+    if (head.next == nullptr) {
         throw std::out_of_range("Calling List<T>::first() on an empty List");
     }
     
-    return head->item;
+    return head.next->item;
     
 }
 
-template<typename T>
-T & List<T>::last() {
+template<typename T, typename Alloc>
+T & List<T, Alloc>::last() {
     
     if (back == nullptr) {
         throw std::out_of_range("Calling List<T>::last() on an empty List");
@@ -402,8 +884,8 @@ T & List<T>::last() {
     
 }
 
-template<typename T>
-const T & List<T>::last() const {
+template<typename T, typename Alloc>
+const T & List<T, Alloc>::last() const {
     
     if (back == nullptr) {
         throw std::out_of_range("Calling List<T>::last() on an empty List");
@@ -415,121 +897,113 @@ const T & List<T>::last() const {
 
 /* Item insertion */
 
-template<typename T>
-List<T> & List<T>::push_back(const T & item) {
-    return push_back_node(new Node(item));
-}
-
-template<typename T>
-List<T> & List<T>::push_back(T & item) {
-    return push_back_node(new Node(item));
-}
-
-template<typename T>
-List<T> & List<T>::push_back(T && item) {
-    return push_back_node(new Node(item));
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::push_back(const T & item) {
+    emplace_back(item);
+    return *this;
 }
 
-template<typename T>
-template<typename... args>
-List<T> & List<T>::push_back(args&... a) {
-    return push_back_node(new Node(a...));
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::push_back(T && item) {
+    emplace_back(std::move(item));
+    return *this;
 }
 
-template<typename T>
+template<typename T, typename Alloc>
 template<typename... args>
-List<T> & List<T>::push_back(args&&... a) {
-    return push_back_node(new Node(a...));
+requires std::constructible_from<T, args&&...>
+List<T, Alloc> & List<T, Alloc>::push_back(args&&... a) {
+    emplace_back(std::forward<args>(a)...);
+    return *this;
 }
 
-template<typename T>
+template<typename T, typename Alloc>
 template<typename... args>
-List<T> & List<T>::push_back(const args&... a) {
-    return push_back_node(new Node(a...));
+T & List<T, Alloc>::emplace_back(args&&... a) {
+    LIST_STATS(call(ListOp::push_back));
+    node_ptr node = create_node(std::forward<args>(a)...);
+    push_back_node(node);
+    return node->item;
 }
 
-template<typename T>
-List<T> & List<T>::push(const T & item) {
-    return push_node(new Node(item));
-}
-
-template<typename T>
-List<T> & List<T>::push(T & item) {
-    return push_node(new Node(item));
-}
-
-template<typename T>
-List<T> & List<T>::push(T && item) {
-    return push_node(new Node(item));
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::push(const T & item) {
+    emplace_front(item);
+    return *this;
 }
 
-template<typename T>
-template<typename... args>
-List<T> & List<T>::push(args&... a) {
-    return push_node(new Node(a...));
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::push(T && item) {
+    emplace_front(std::move(item));
+    return *this;
 }
 
-template<typename T>
+template<typename T, typename Alloc>
 template<typename... args>
-List<T> & List<T>::push(args&&... a) {
-    return push_node(new Node(a...));
+requires std::constructible_from<T, args&&...>
+List<T, Alloc> & List<T, Alloc>::push(args&&... a) {
+    emplace_front(std::forward<args>(a)...);
+    return *this;
 }
 
-template<typename T>
+template<typename T, typename Alloc>
 template<typename... args>
-List<T> & List<T>::push(const args&... a) {
-    return push_node(new Node(a...));
-}
-
-template<typename T>
-List<T> & List<T>::insert(const size_t index, const T & item) {
-    return insert_node(index, new Node(item));
+T & List<T, Alloc>::emplace_front(args&&... a) {
+    LIST_STATS(call(ListOp::push));
+    node_ptr node = create_node(std::forward<args>(a)...);
+    push_node(node);
+    return node->item;
 }
 
-template<typename T>
-List<T> & List<T>::insert(const size_t index, T & item) {
-    return insert_node(index, new Node(item));
-}
-
-template<typename T>
-List<T> & List<T>::insert(const size_t index, T && item) {
-    return insert_node(index, new Node(item));
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::insert(const size_t index, const T & item) {
+    emplace(index, item);
+    return *this;
 }
 
-template<typename T>
-template<typename... args>
-List<T> & List<T>::insert(const size_t index, args&... a) {
-    return insert_node(index, new Node(a...));
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::insert(const size_t index, T && item) {
+    emplace(index, std::move(item));
+    return *this;
 }
 
-template<typename T>
+template<typename T, typename Alloc>
 template<typename... args>
-List<T> & List<T>::insert(const size_t index, args&&... a) {
-    return insert_node(index, new Node(a...));
+requires std::constructible_from<T, args&&...>
+List<T, Alloc> & List<T, Alloc>::insert(const size_t index, args&&... a) {
+    emplace(index, std::forward<args>(a)...);
+    return *this;
 }
 
-template<typename T>
+template<typename T, typename Alloc>
 template<typename... args>
-List<T> & List<T>::insert(const size_t index, const args&... a) {
-    return insert_node(index, new Node(a...));
+T & List<T, Alloc>::emplace(const size_t index, args&&... a) {
+    LIST_STATS(call(ListOp::insert));
+    checkIndexRange(index);
+    node_ptr node = create_node(std::forward<args>(a)...);
+    insert_node(index, node);
+    return node->item;
 }
 
 /* Item extraction */
 
-template<typename T>
-T List<T>::pop_front() {
+template<typename T, typename Alloc>
+T List<T, Alloc>::pop_front() {
     
-    if (head == nullptr) {
+    LIST_STATS(call(ListOp::pop_front));
+    
+    if (head.next == nullptr) {
         throw std::runtime_error("");
     }
     
-    node_ptr temp = head;
+    reset_cursor();
+    node_ptr temp = head.next;
     T retval(std::move(temp->item));
-    head = head->next;
+    head.next = head.next->next;
     --len;
-    delete temp;
+    destroy_node(temp);
     
-    if (head == nullptr) {
+    if (head.next == nullptr) {
         back = nullptr;
     }
     
@@ -537,19 +1011,23 @@ T List<T>::pop_front() {
     
 }
 
-template<typename T>
-T List<T>::pop_back() {
+template<typename T, typename Alloc>
+T List<T, Alloc>::pop_back() {
     
-    if (head == nullptr) {
+    LIST_STATS(call(ListOp::pop_back));
+    
+    if (head.next == nullptr) {
         throw std::runtime_error("");
     }
     if (len == 1) {
         return pop_front();
     }
     
+    LIST_STATS(pop_back_scan());
     node_ptr ptr = node_at(len - 2);
-    T retval(std::move(ptr->item));
-    delete ptr->next;
+    T retval(std::move(ptr->next->item));
+    reset_cursor();
+    destroy_node(ptr->next);
     ptr->next = nullptr;
     back = ptr;
     --len;
@@ -557,8 +1035,10 @@ T List<T>::pop_back() {
     
 }
 
-template<typename T>
-T List<T>::remove(const size_t index) {
+template<typename T, typename Alloc>
+T List<T, Alloc>::remove(const size_t index) {
+    
+    LIST_STATS(call(ListOp::remove));
     
     checkIndexRange(index);
     if (not index) {
@@ -570,145 +1050,462 @@ T List<T>::remove(const size_t index) {
     
     node_ptr ptr = node_at(index - 1);
     T retval(std::move(ptr->next->item));
+    reset_cursor();
     node_ptr next = ptr->next->next;
-    delete ptr->next;
+    destroy_node(ptr->next);
     ptr->next = next;
     --len;
     return retval;
     
 }
 
+/* Insert, remove and splice after iterator */
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::iterator
+List<T, Alloc>::insert_after(const_iterator pos, const T & item) {
+    return emplace_after(pos, item);
+}
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::iterator
+List<T, Alloc>::insert_after(const_iterator pos, T && item) {
+    return emplace_after(pos, std::move(item));
+}
+
+template<typename T, typename Alloc>
+template<typename... args>
+typename List<T, Alloc>::iterator
+List<T, Alloc>::emplace_after(const_iterator pos, args&&... a) {
+    LIST_STATS(call(ListOp::insert_after));
+    node_ptr node = create_node(std::forward<args>(a)...);
+    return iterator(link_after(pos.node, node));
+}
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::iterator List<T, Alloc>::erase_after(const_iterator pos) {
+    LIST_STATS(call(ListOp::erase_after));
+    destroy_node(unlink_after(pos.node));
+    return iterator(pos.node->next);
+}
+
+template<typename T, typename Alloc>
+typename List<T, Alloc>::iterator
+List<T, Alloc>::erase_after(const_iterator first, const_iterator last) {
+    
+    LIST_STATS(call(ListOp::erase_after));
+    
+    while (first.node->next != last.node) {
+        destroy_node(unlink_after(first.node));
+    }
+    
+    return iterator(last.node);
+    
+}
+
+template<typename T, typename Alloc>
+void List<T, Alloc>::splice_after(const_iterator pos, List<T, Alloc> && l) {
+    
+    LIST_STATS(call(ListOp::splice_after));
+    
+    if (&l == this or l.len == 0) {
+        return;
+    }
+    
+    if (not shares_allocator(l)) {
+        link_ptr ptr = pos.node;
+        for (T & item : l) {
+            ptr = link_after(ptr, create_node(std::move(item)));
+        }
+        l.clear();
+        return;
+    }
+    
+    if (pos.node->next == nullptr) {
+        back = l.back;
+    }
+    l.back->next = pos.node->next;
+    pos.node->next = l.head.next;
+    len += l.len;
+    LIST_STATS(length(len));
+    reset_cursor();
+    
+    l.head.next = nullptr;
+    l.back = nullptr;
+    l.len = 0;
+    l.reset_cursor();
+    
+}
+
+template<typename T, typename Alloc>
+void List<T, Alloc>::splice_after(const_iterator pos, List<T, Alloc> && l,
+                                  const_iterator it) {
+    
+    LIST_STATS(call(ListOp::splice_after));
+    
+    link_ptr prev = it.node;
+    if (pos.node == prev or pos.node == prev->next) {
+        return;
+    }
+    
+    if (not shares_allocator(l)) {
+        emplace_after(pos, std::move(prev->next->item));
+        l.erase_after(it);
+        return;
+    }
+    
+    link_after(pos.node, l.unlink_after(prev));
+    
+}
+
+/* Moves (first, last), which takes a walk over the range to find its end */
+
+template<typename T, typename Alloc>
+void List<T, Alloc>::splice_after(const_iterator pos, List<T, Alloc> && l,
+                                  const_iterator first, const_iterator last) {
+    
+    LIST_STATS(call(ListOp::splice_after));
+    
+    if (first == last or first.node->next == last.node) {
+        return;
+    }
+    
+    if (not shares_allocator(l)) {
+        link_ptr ptr = pos.node;
+        while (first.node->next != last.node) {
+            ptr = link_after(ptr, create_node(std::move(first.node->next->item)));
+            l.destroy_node(l.unlink_after(first.node));
+        }
+        return;
+    }
+    
+    node_ptr begin = first.node->next;
+    node_ptr end = begin;
+    size_t count = 1;
+    while (end->next != last.node) {
+        end = end->next;
+        ++count;
+    }
+    
+    first.node->next = end->next;
+    if (l.back == end) {
+        l.back = first.node == &l.head ? nullptr
+                                       : static_cast<node_ptr>(first.node);
+    }
+    l.len -= count;
+    l.reset_cursor();
+    
+    if (pos.node->next == nullptr) {
+        back = end;
+    }
+    end->next = pos.node->next;
+    pos.node->next = begin;
+    len += count;
+    LIST_STATS(length(len));
+    reset_cursor();
+    
+}
+
 /* List concatenation */
 
-template<typename T>
-List<T> List<T>::concatenate(const List<T> & l) const {
-    List<T> copy = List<T>(*this);
+template<typename T, typename Alloc>
+List<T, Alloc> List<T, Alloc>::concatenate(const List<T, Alloc> & l) const {
+    List<T, Alloc> copy = List<T, Alloc>(*this);
     copy += l;
     return copy;
 }
 
-template<typename T>
-List<T> List<T>::operator+(const List<T> & l) const {
+template<typename T, typename Alloc>
+List<T, Alloc> List<T, Alloc>::operator+(const List<T, Alloc> & l) const {
     return concatenate(l);
 }
 
-template<typename T>
-List<T> List<T>::concatenate(List<T> && l) const {
-    List<T> copy = List<T>(*this);
-    copy += l;
+template<typename T, typename Alloc>
+List<T, Alloc> List<T, Alloc>::concatenate(List<T, Alloc> && l) const {
+    List<T, Alloc> copy = List<T, Alloc>(*this);
+    copy += std::move(l);
     return copy;
 }
 
-template<typename T>
-List<T> List<T>::operator+(List<T> && l) const {
-    return concatenate(l);
+template<typename T, typename Alloc>
+List<T, Alloc> List<T, Alloc>::operator+(List<T, Alloc> && l) const {
+    return concatenate(std::move(l));
 }
 
-template<typename T>
-List<T> & List<T>::append(const List<T> & l) {
-    for (size_t i = 0; i < l.len; ++i) {
-        push_back(l[i]);
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::append(const List<T, Alloc> & l) {
+    
+    LIST_STATS(call(ListOp::append));
+    
+    if (l.len == 0) {
+        return *this;
+    }
+    
+    /* Copy l.len nodes first, so appending a list to itself terminates */
+    /* and a throwing copy leaves this list untouched                   */
+    
+    node_ptr last;
+    node_ptr first = copy_chain(l.head.next, l.len, last);
+    
+    if (back) {
+        back->next = first;
+    } else {
+        head.next = first;
     }
+    back = last;
+    len += l.len;
+    LIST_STATS(length(len));
+    
     return *this;
+    
 }
 
-template<typename T>
-List<T> & List<T>::operator+=(const List<T> & l) {
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::operator+=(const List<T, Alloc> & l) {
     return append(l);
 }
 
-template<typename T>
-List<T> & List<T>::append(List<T> && l) {
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::append(List<T, Alloc> && l) {
+    
+    LIST_STATS(call(ListOp::append));
+    
+    if (&l == this or l.len == 0) {
+        return *this;
+    }
     
-    back->next = l.head;
+    if (not shares_allocator(l)) {
+        for (T & item : l) {
+            push_back(std::move(item));
+        }
+        l.clear();
+        return *this;
+    }
+    
+    if (back) {
+        back->next = l.head.next;
+    } else {
+        head.next = l.head.next;
+    }
+    back = l.back;
     len += l.len;
+    LIST_STATS(length(len));
     
-    l.head = nullptr;
+    l.head.next = nullptr;
+    l.back = nullptr;
     l.len = 0;
+    l.reset_cursor();
     
     return *this;
     
 }
 
-template<typename T>
-List<T> & List<T>::operator+=(List<T> && l) {
-    return append(l);
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::operator+=(List<T, Alloc> && l) {
+    return append(std::move(l));
 }
 
 /* Assignment */
 
-template<typename T>
-List<T> & List<T>::assign(const List<T> & l) {
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::assign(const List<T, Alloc> & l) {
     
-    clear();
-    for (size_t i = 0; i < l.len; ++i) {
-        push_back(l[i]);
+    LIST_STATS(call(ListOp::assign));
+    
+    if (&l == this) {
+        return *this;
+    }
+    
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+        if (not shares_allocator(l)) {
+            List<T, Alloc> copy{Alloc(l.alloc)};
+            copy.append(l);
+            clear();
+            alloc = l.alloc;
+            steal(copy);
+            return *this;
+        }
+        alloc = l.alloc;
+    }
+    
+    if constexpr (not std::is_nothrow_copy_assignable_v<T>) {
+        
+        /* Copy and swap, the old nodes go only once the copy succeeded */
+        
+        node_ptr last = nullptr;
+        node_ptr first = copy_chain(l.head.next, l.len, last);
+        clear();
+        head.next = first;
+        back = last;
+        len = l.len;
+        LIST_STATS(length(len));
+        return *this;
+        
+    } else {
+        
+        /* Reuse the existing nodes, only the nodes past our length are */
+        /* allocated, and they are allocated before anything is touched */
+        
+        const size_t reused = std::min(len, l.len);
+        
+        node_ptr src = l.head.next;
+        node_ptr tail = nullptr;
+        node_ptr tailLast = nullptr;
+        if (l.len > len) {
+            node_ptr tailSrc = src;
+            for (size_t i = 0; i < reused; ++i) {
+                tailSrc = tailSrc->next;
+            }
+            tail = copy_chain(tailSrc, l.len - len, tailLast);
+        }
+        
+        link_ptr prev = &head;
+        node_ptr dst = head.next;
+        for (size_t i = 0; i < reused; ++i) {
+            dst->item = src->item;
+            prev = dst;
+            dst = dst->next;
+            src = src->next;
+        }
+        
+        if (tail) {
+            prev->next = tail;
+            back = tailLast;
+        } else {
+            prev->next = nullptr;
+            destroy_chain(dst);
+            back = prev == &head ? nullptr : static_cast<node_ptr>(prev);
+        }
+        len = l.len;
+        LIST_STATS(length(len));
+        reset_cursor();
+        return *this;
+        
     }
-    return *this;
     
 }
 
-template<typename T>
-List<T> & List<T>::operator=(const List<T> & l) {
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::operator=(const List<T, Alloc> & l) {
     return assign(l);
 }
 
-template<typename T>
-List<T> & List<T>::assign(List<T> && l) {
-    len = l.len;
-    head = l.head;
-    l.head = nullptr;
-    l.len = 0;
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::assign(List<T, Alloc> && l)
+    noexcept(node_traits::propagate_on_container_move_assignment::value or
+             node_traits::is_always_equal::value) {
+    
+    LIST_STATS(call(ListOp::assign));
+    
+    if (&l == this) {
+        return *this;
+    }
+    
+    clear();
+    if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+        alloc = l.alloc;
+    } else if (not shares_allocator(l)) {
+        return append(std::move(l));
+    }
+    steal(l);
     return *this;
+    
 }
 
-template<typename T>
-List<T> & List<T>::operator=(List<T> && l) {
-    return assign(l);
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::operator=(List<T, Alloc> && l)
+    noexcept(node_traits::propagate_on_container_move_assignment::value or
+             node_traits::is_always_equal::value) {
+    return assign(std::move(l));
+}
+
+/* Swap heads, the nodes themselves stay where they are. Unequal */
+/* allocators that don't propagate on swap are undefined, as for */
+/* the standard containers, except for inline node storage,      */
+/* which swaps the items through a temporary                     */
+
+template<typename T, typename Alloc>
+void List<T, Alloc>::swap(List<T, Alloc> & l)
+    noexcept(not allocator_stores_nodes_inline<Alloc>::value) {
+    
+    if constexpr (allocator_stores_nodes_inline<Alloc>::value) {
+        if (&l != this) {
+            List<T, Alloc> tmp(std::move(l));
+            l.assign(std::move(*this));
+            assign(std::move(tmp));
+        }
+        return;
+    }
+    
+    if constexpr (node_traits::propagate_on_container_swap::value) {
+        std::swap(alloc, l.alloc);
+    }
+    std::swap(head.next, l.head.next);
+    std::swap(back, l.back);
+    std::swap(len, l.len);
+    reset_cursor();
+    l.reset_cursor();
+    
 }
 
 /* Utility functions */
 
-template<typename T>
-size_t List<T>::size() const {
+template<typename T, typename Alloc>
+size_t List<T, Alloc>::size() const {
     return len;
 }
 
-template<typename T>
-List<T> List<T>::map(std::function<T(const T&)> fun) const {
+template<typename T, typename Alloc>
+template<typename Fun, typename U>
+requires std::invocable<Fun &, const T &>
+List<U, typename std::allocator_traits<Alloc>::template rebind_alloc<U>>
+List<T, Alloc>::map(Fun fun) const {
+    
+    LIST_STATS(call(ListOp::map));
     
-    List<T> l;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<U>
+        result_allocator;
+    List<U, result_allocator> l((result_allocator(alloc)));
     
-    for (size_t i = 0; i < len; ++i) {
-        l.push_back(fun(at(i)));
+    for (node_ptr ptr = head.next; ptr != nullptr; ptr = ptr->next) {
+        LIST_PREFETCH(ptr->next);
+        l.push_back(std::invoke(fun, ptr->item));
     }
     
     return l;
     
 }
 
-template<typename T>
-template<typename Acc>
-Acc List<T>::fold(std::function<void(Acc & acc, const T&)> fun,
-                  Acc initVal) const {
+template<typename T, typename Alloc>
+template<typename Acc, typename Fun>
+requires std::invocable<Fun &, Acc &, const T &>
+Acc List<T, Alloc>::fold(Fun fun, Acc initVal) const {
+    
+    LIST_STATS(call(ListOp::fold));
     
-    for (size_t i = 0; i < len; ++i) {
-        fun(initVal, at(i));
+    for (node_ptr ptr = head.next; ptr != nullptr; ptr = ptr->next) {
+        LIST_PREFETCH(ptr->next);
+        std::invoke(fun, initVal, ptr->item);
     }
     
     return initVal;
     
 }
 
-template<typename T>
-List<T> List<T>::filter(std::function<bool(const T&)> fun) const {
+template<typename T, typename Alloc>
+template<typename Fun>
+requires std::predicate<Fun &, const T &>
+List<T, Alloc> List<T, Alloc>::filter(Fun fun) const {
     
-    List<T> l;
+    LIST_STATS(call(ListOp::filter));
     
-    for (size_t i = 0; i < len; ++i) {
+    List<T, Alloc> l(get_allocator());
+    
+    for (node_ptr ptr = head.next; ptr != nullptr; ptr = ptr->next) {
         
-        const T & item = at(i);
-        if (fun(item)) {
+        LIST_PREFETCH(ptr->next);
+        const T & item = ptr->item;
+        if (std::invoke(fun, item)) {
             l.push_back(item);
         }
         
@@ -718,38 +1515,251 @@ List<T> List<T>::filter(std::function<bool(const T&)> fun) const {
     
 }
 
-template<typename T>
-List<T> & List<T>::clear() {
+template<typename T, typename Alloc>
+template<typename Fun>
+requires std::predicate<Fun &, const T &>
+size_t List<T, Alloc>::remove_if(Fun fun) {
+    
+    LIST_STATS(call(ListOp::remove_if));
+    
+    size_t removed = 0;
+    link_ptr prev = &head;
+    
+    while (prev->next != nullptr) {
+        const T & item = prev->next->item;
+        if (std::invoke(fun, item)) {
+            destroy_node(unlink_after(prev));
+            ++removed;
+        } else {
+            prev = prev->next;
+        }
+    }
+    
+    return removed;
+    
+}
+
+template<typename T, typename Alloc>
+template<typename Fun>
+requires std::predicate<Fun &, const T &>
+size_t List<T, Alloc>::retain(Fun fun) {
+    return remove_if([&fun](const T & item) {
+        return not std::invoke(fun, item);
+    });
+}
+
+/* Ordering */
+
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::sort() {
+    return sort(std::less<>());
+}
+
+/* Bottom up merge sort, pass k merges neighbouring sorted runs of 2^k */
+/* nodes, so no recursion and no extra memory is needed               */
+
+template<typename T, typename Alloc>
+template<typename Compare>
+requires std::strict_weak_order<Compare &, const T &, const T &>
+List<T, Alloc> & List<T, Alloc>::sort(Compare comp) {
+    
+    LIST_STATS(call(ListOp::sort));
+    
+    reset_cursor();
+    
+    for (size_t width = 1; width < len; width *= 2) {
+        
+        link_ptr tail = &head;
+        node_ptr rest = head.next;
+        
+        while (rest != nullptr) {
+            node_ptr left = rest;
+            node_ptr right = cut_after(left, width);
+            rest = cut_after(right, width);
+            try {
+                tail = merge_chains(tail, left, right, comp);
+            } catch (...) {
+                last_of(tail)->next = rest;
+                back = last_of(&head);
+                throw;
+            }
+        }
+        
+        back = static_cast<node_ptr>(tail);
+        
+    }
+    
+    return *this;
+    
+}
+
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::merge(List<T, Alloc> && l) {
+    return merge(std::move(l), std::less<>());
+}
+
+template<typename T, typename Alloc>
+template<typename Compare>
+requires std::strict_weak_order<Compare &, const T &, const T &>
+List<T, Alloc> & List<T, Alloc>::merge(List<T, Alloc> && l, Compare comp) {
+    
+    LIST_STATS(call(ListOp::merge));
+    
+    if (&l == this or l.len == 0) {
+        return *this;
+    }
+    
+    if (len == 0) {
+        return append(std::move(l));
+    }
+    
+    /* Take the nodes first, so a throwing comp leaves them all here. */
+    /* Items of a list with another allocator move into our own nodes */
+    /* after back first, and the two runs are cut apart again         */
+    
+    node_ptr other = nullptr;
+    if (shares_allocator(l)) {
+        other = l.head.next;
+        len += l.len;
+        LIST_STATS(length(len));
+        l.head.next = nullptr;
+        l.back = nullptr;
+        l.len = 0;
+        l.reset_cursor();
+    } else {
+        const size_t ours = len;
+        append(std::move(l));
+        other = cut_after(head.next, ours);
+    }
+    reset_cursor();
+    
+    try {
+        back = merge_chains(&head, head.next, other, comp);
+    } catch (...) {
+        back = last_of(&head);
+        throw;
+    }
+    
+    return *this;
+    
+}
+
+template<typename T, typename Alloc>
+size_t List<T, Alloc>::unique() {
+    return unique(std::equal_to<>());
+}
+
+/* Removes all but the first of every run of consecutive equal items */
+
+template<typename T, typename Alloc>
+template<typename Fun>
+requires std::predicate<Fun &, const T &, const T &>
+size_t List<T, Alloc>::unique(Fun fun) {
+    
+    LIST_STATS(call(ListOp::unique));
+    
+    if (head.next == nullptr) {
+        return 0;
+    }
+    
+    size_t removed = 0;
+    node_ptr prev = head.next;
+    
+    while (prev->next != nullptr) {
+        if (std::invoke(fun, prev->item, prev->next->item)) {
+            destroy_node(unlink_after(prev));
+            ++removed;
+        } else {
+            prev = prev->next;
+        }
+    }
+    
+    return removed;
+    
+}
+
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::reverse() {
     
-    while(head != nullptr) {
-        pop_front();
+    LIST_STATS(call(ListOp::reverse));
+    
+    node_ptr reversed = nullptr;
+    node_ptr ptr = head.next;
+    back = ptr;
+    
+    while (ptr != nullptr) {
+        node_ptr next = ptr->next;
+        ptr->next = reversed;
+        reversed = ptr;
+        ptr = next;
     }
     
+    head.next = reversed;
+    reset_cursor();
+    return *this;
+    
+}
+
+template<typename T, typename Alloc>
+List<T, Alloc> & List<T, Alloc>::clear() {
+    
+    LIST_STATS(call(ListOp::clear));
+    
+    if constexpr (not std::is_trivially_destructible_v<T> or
+                  not allocator_releases_in_bulk<node_allocator>::value) {
+        destroy_chain(head.next);
+    } else {
+        LIST_STATS(freed(len));
+    }
+    
+    head.next = nullptr;
+    back = nullptr;
     len = 0;
+    reset_cursor();
     
     return *this;
 }
 
 /* Constructors */
 
-template<typename T>
-List<T>::List() { }
+template<typename T, typename Alloc>
+List<T, Alloc>::List() { }
+
+template<typename T, typename Alloc>
+List<T, Alloc>::List(const Alloc & allocator) : alloc(allocator) { }
 
-template<typename T>
-List<T>::List(const List<T> & orig) {
-    assign(orig);
+template<typename T, typename Alloc>
+List<T, Alloc>::List(const List<T, Alloc> & orig)
+    : alloc(node_traits::select_on_container_copy_construction(orig.alloc)) {
+    LIST_STATS(call(ListOp::copy));
+    append(orig);
 }
 
-template<typename T>
-List<T>::List(List<T> && orig) {
-    assign(orig);
+template<typename T, typename Alloc>
+List<T, Alloc>::List(List<T, Alloc> && orig)
+    noexcept(not allocator_stores_nodes_inline<Alloc>::value) : alloc(orig.alloc) {
+    
+    if constexpr (allocator_stores_nodes_inline<Alloc>::value) {
+        append(std::move(orig));
+    } else {
+        steal(orig);
+    }
+    
 }
 
 /* Destructor */
 
-template<typename T>
-List<T>::~List<T>() {
+template<typename T, typename Alloc>
+List<T, Alloc>::~List() {
     clear();
 }
 
+/* Swap */
+
+template<typename T, typename Alloc>
+void swap(List<T, Alloc> & lhs, List<T, Alloc> & rhs)
+    noexcept(not allocator_stores_nodes_inline<Alloc>::value) {
+    lhs.swap(rhs);
+}
+
 #endif /* list_hpp */
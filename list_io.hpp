@@ -0,0 +1,507 @@
+//
+//  list_io.hpp
+//  linked_list
+//
+//  Compact binary format for List<T> with trivially copyable T: a 32 byte
+//  header followed by the items back to back. read_binary() loads a file
+//  into a List in bulk, MappedList<T> maps one read-only and iterates the
+//  items in place without deserializing anything.
+//
+
+#ifndef list_io_hpp
+#define list_io_hpp
+
+#include <istream>
+#include <ostream>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+
+/* MappedList needs POSIX mmap(), the stream functions work anywhere */
+
+#if __has_include(<sys/mman.h>)
+#define LIST_IO_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "list.hpp"
+
+
+/*************************************************************************/
+/*                                                                       */
+/* ********************************************************************* */
+/* **************************** Declaration **************************** */
+/* ********************************************************************* */
+/*                                                                       */
+/*************************************************************************/
+
+
+/* Items are stored in native byte order. version is written natively */
+/* as well, so a file from a machine of the other endianness is       */
+/* rejected instead of read garbled                                   */
+
+struct ListFileHeader {
+    
+    static constexpr char expectedMagic[8] = { 'L', 'L', 'I', 'S', 'T', 'B', 'I', 'N' };
+    static constexpr uint32_t currentVersion = 1;
+    
+    char magic[8];
+    uint32_t version;
+    uint32_t itemAlign;
+    uint64_t itemSize;
+    uint64_t count;
+    
+    template<typename T>
+    static ListFileHeader describe(const uint64_t count);
+    
+    /* Throws std::runtime_error unless the header describes T items */
+    
+    template<typename T>
+    void check() const;
+    
+};
+
+static_assert(sizeof(ListFileHeader) == 32);
+
+template<typename T>
+concept binary_serializable = std::is_trivially_copyable_v<T> and
+                              alignof(T) <= sizeof(ListFileHeader);
+
+/* Writes the header and the items, throws std::runtime_error if the */
+/* stream fails                                                      */
+
+template<binary_serializable T, typename Alloc>
+void write_binary(const List<T, Alloc> & list, std::ostream & out);
+
+/* Reads a list written by write_binary(). Allocators that release in */
+/* bulk (allocator_releases_in_bulk) get one allocation for all nodes, */
+/* linked in one pass, when the stream can seek to check its length.  */
+/* Otherwise there's one allocation per node. The items are read in   */
+/* large blocks either way. Throws std::runtime_error if the stream   */
+/* holds fewer items than the header claims                           */
+
+template<binary_serializable T, typename Alloc = std::allocator<T>>
+List<T, Alloc> read_binary(std::istream & in, const Alloc & allocator = Alloc());
+
+#ifdef LIST_IO_HAS_MMAP
+
+/* Read-only view of a file written by write_binary(), mapped with */
+/* mmap(). The items are used where they lie in the file, opening  */
+/* costs the same for any length                                   */
+
+template<binary_serializable T>
+class MappedList {
+    
+    void * mapping = nullptr;
+    size_t mappedBytes = 0;
+    const T * items = nullptr;
+    size_t len = 0;
+    
+    void unmap();
+    
+public:
+    
+    typedef T value_type;
+    typedef const T & reference;
+    typedef const T & const_reference;
+    typedef const T * iterator;
+    typedef const T * const_iterator;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    
+    /* Iterators */
+    
+    const_iterator begin() const;
+    const_iterator end() const;
+    
+    /* Element access */
+    
+    const T & at(const size_t index) const;
+    const T & operator[](const size_t index) const;
+    
+    /* Utility */
+    
+    size_t size() const;
+    
+    /* Constructors, throw std::system_error if the file can't be */
+    /* mapped and std::runtime_error if it holds no T items       */
+    
+    explicit MappedList(const std::string & path);
+    MappedList(const MappedList<T> &) = delete;
+    MappedList<T> & operator=(const MappedList<T> &) = delete;
+    MappedList(MappedList<T> && orig) noexcept;
+    MappedList<T> & operator=(MappedList<T> && orig) noexcept;
+    
+    /* Destructor */
+    
+    ~MappedList();
+    
+};
+
+#endif /* LIST_IO_HAS_MMAP */
+
+/**************************************************************************/
+/*                                                                        */
+/* ********************************************************************** */
+/* *************************** Implementation *************************** */
+/* ********************************************************************** */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**********************/
+/*   ListFileHeader   */
+/**********************/
+
+template<typename T>
+ListFileHeader ListFileHeader::describe(const uint64_t count) {
+    
+    ListFileHeader header;
+    std::memcpy(header.magic, expectedMagic, sizeof(magic));
+    header.version = currentVersion;
+    header.itemAlign = alignof(T);
+    header.itemSize = sizeof(T);
+    header.count = count;
+    return header;
+    
+}
+
+template<typename T>
+void ListFileHeader::check() const {
+    
+    if (std::memcmp(magic, expectedMagic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a binary List file");
+    }
+    if (version != currentVersion) {
+        throw std::runtime_error("Unsupported binary List version or byte order");
+    }
+    if (itemSize != sizeof(T) or itemAlign != alignof(T)) {
+        throw std::runtime_error("Binary List file holds items of another type");
+    }
+    
+}
+
+
+/**********************/
+/*      Internal      */
+/**********************/
+
+/* Items go through a buffer of this many bytes at a time */
+
+inline constexpr size_t list_io_block = 1 << 16;
+
+struct ListBinaryIO {
+    
+    /* Bytes between the read position and the end of the stream, -1 */
+    /* for streams that can't seek                                   */
+    
+    static std::streamoff remaining(std::istream & in);
+    
+    template<typename T, typename Alloc>
+    static void load(List<T, Alloc> & list, std::istream & in, const size_t count);
+    
+};
+
+inline std::streamoff ListBinaryIO::remaining(std::istream & in) {
+    
+    const std::istream::pos_type here = in.tellg();
+    if (here == std::istream::pos_type(-1)) {
+        in.clear();
+        return -1;
+    }
+    
+    in.seekg(0, std::ios::end);
+    const std::istream::pos_type end = in.tellg();
+    in.clear();
+    in.seekg(here);
+    
+    if (end == std::istream::pos_type(-1) or not in) {
+        in.clear();
+        return -1;
+    }
+    return end - here;
+    
+}
+
+template<typename T, typename Alloc>
+void ListBinaryIO::load(List<T, Alloc> & list, std::istream & in, const size_t count) {
+    
+    typedef typename List<T, Alloc>::node_ptr node_ptr;
+    typedef typename List<T, Alloc>::node_traits node_traits;
+    
+    /* The count comes from the file, so it's checked against what the */
+    /* stream holds before anything is sized by it                     */
+    
+    const std::streamoff available = remaining(in);
+    if (available >= 0 and count > size_t(available) / sizeof(T)) {
+        throw std::runtime_error("Binary List file is truncated");
+    }
+    
+    /* Raw storage, T need not be default constructible. Reading the */
+    /* bytes in is what creates the trivially copyable items         */
+    
+    const size_t perBlock = std::max<size_t>(list_io_block / sizeof(T), 1);
+    const size_t blockSize = std::min(count, perBlock);
+    const auto release = [blockSize](T * ptr) {
+        std::allocator<T>().deallocate(ptr, blockSize);
+    };
+    std::unique_ptr<T, decltype(release)> block(
+        std::allocator<T>().allocate(blockSize), release);
+    
+    const auto readBlock = [&in, &block](const size_t items) {
+        in.read(reinterpret_cast<char *>(block.get()),
+                std::streamsize(items * sizeof(T)));
+        if (not in) {
+            throw std::runtime_error("Binary List file is truncated");
+        }
+    };
+    
+    if constexpr (allocator_releases_in_bulk<
+                      typename List<T, Alloc>::node_allocator>::value) {
+        
+        /* One array for every node. Nodes of such allocators are never */
+        /* freed one by one, and trivially copyable items need no       */
+        /* destructor, so the list may own the array node by node. A    */
+        /* stream of unknown length gets the node by node load below,   */
+        /* which allocates only for items actually read                 */
+        
+        if (available >= 0) {
+            
+            node_ptr nodes = node_traits::allocate(list.alloc, count);
+            
+            for (size_t done = 0; done < count; ) {
+                const size_t items = std::min(count - done, perBlock);
+                readBlock(items);
+                for (size_t i = 0; i < items; ++i) {
+                    node_ptr node = nodes + done + i;
+                    node_traits::construct(list.alloc, node, std::in_place, block.get()[i]);
+                    node->next = done + i + 1 < count ? node + 1 : nullptr;
+                }
+                done += items;
+            }
+            
+            list.head.next = nodes;
+            list.back = nodes + count - 1;
+            list.len = count;
+            LIST_STATS(allocated(count));
+            LIST_STATS(length(count));
+            return;
+            
+        }
+        
+    }
+    
+    for (size_t done = 0; done < count; ) {
+        const size_t items = std::min(count - done, perBlock);
+        readBlock(items);
+        for (size_t i = 0; i < items; ++i) {
+            list.emplace_back(block.get()[i]);
+        }
+        done += items;
+    }
+    
+}
+
+
+/**********************/
+/*       Public       */
+/**********************/
+
+template<binary_serializable T, typename Alloc>
+void write_binary(const List<T, Alloc> & list, std::ostream & out) {
+    
+    const ListFileHeader header = ListFileHeader::describe<T>(list.size());
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    
+    /* Items are gathered into blocks, a write per item costs more */
+    /* than the copy                                               */
+    
+    const size_t perBlock = std::max<size_t>(list_io_block / sizeof(T), 1);
+    std::vector<T> block;
+    block.reserve(std::min(list.size(), perBlock));
+    
+    for (const T & item : list) {
+        block.push_back(item);
+        if (block.size() == perBlock) {
+            out.write(reinterpret_cast<const char *>(block.data()),
+                      std::streamsize(block.size() * sizeof(T)));
+            block.clear();
+        }
+    }
+    out.write(reinterpret_cast<const char *>(block.data()),
+              std::streamsize(block.size() * sizeof(T)));
+    
+    if (not out) {
+        throw std::runtime_error("Writing binary List failed");
+    }
+    
+}
+
+template<binary_serializable T, typename Alloc>
+List<T, Alloc> read_binary(std::istream & in, const Alloc & allocator) {
+    
+    ListFileHeader header;
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (not in) {
+        throw std::runtime_error("Binary List file is truncated");
+    }
+    header.check<T>();
+    
+    List<T, Alloc> list(allocator);
+    if (header.count != 0) {
+        ListBinaryIO::load(list, in, size_t(header.count));
+    }
+    return list;
+    
+}
+
+
+#ifdef LIST_IO_HAS_MMAP
+
+/********************************************************************/
+/*                                                                  */
+/*                            MappedList                            */
+/*                                                                  */
+/********************************************************************/
+
+/* Internal */
+
+template<binary_serializable T>
+void MappedList<T>::unmap() {
+    if (mapping != nullptr) {
+        munmap(mapping, mappedBytes);
+    }
+    mapping = nullptr;
+    mappedBytes = 0;
+    items = nullptr;
+    len = 0;
+}
+
+/* Iterators */
+
+template<binary_serializable T>
+typename MappedList<T>::const_iterator MappedList<T>::begin() const {
+    return items;
+}
+
+template<binary_serializable T>
+typename MappedList<T>::const_iterator MappedList<T>::end() const {
+    return items + len;
+}
+
+/* Element access */
+
+template<binary_serializable T>
+const T & MappedList<T>::at(const size_t index) const {
+    if (index >= len) {
+        throw std::out_of_range("MappedList index out of range.");
+    }
+    return items[index];
+}
+
+template<binary_serializable T>
+const T & MappedList<T>::operator[](const size_t index) const {
+    return at(index);
+}
+
+/* Utility */
+
+template<binary_serializable T>
+size_t MappedList<T>::size() const {
+    return len;
+}
+
+/* Constructors */
+
+template<binary_serializable T>
+MappedList<T>::MappedList(const std::string & path) {
+    
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        const int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "fstat " + path);
+    }
+    
+    mappedBytes = size_t(info.st_size);
+    if (mappedBytes < sizeof(ListFileHeader)) {
+        close(fd);
+        throw std::runtime_error("Binary List file is truncated");
+    }
+    
+    mapping = mmap(nullptr, mappedBytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::system_error(error, std::generic_category(), "mmap " + path);
+    }
+    
+    try {
+        
+        ListFileHeader header;
+        std::memcpy(&header, mapping, sizeof(header));
+        header.check<T>();
+        if (header.count > (mappedBytes - sizeof(header)) / sizeof(T)) {
+            throw std::runtime_error("Binary List file is truncated");
+        }
+        
+        items = reinterpret_cast<const T *>(
+            static_cast<const char *>(mapping) + sizeof(header));
+        len = size_t(header.count);
+        
+    } catch (...) {
+        unmap();
+        throw;
+    }
+    
+}
+
+template<binary_serializable T>
+MappedList<T>::MappedList(MappedList<T> && orig) noexcept
+    : mapping(std::exchange(orig.mapping, nullptr)),
+      mappedBytes(std::exchange(orig.mappedBytes, 0)),
+      items(std::exchange(orig.items, nullptr)),
+      len(std::exchange(orig.len, 0)) { }
+
+template<binary_serializable T>
+MappedList<T> & MappedList<T>::operator=(MappedList<T> && orig) noexcept {
+    
+    if (&orig != this) {
+        unmap();
+        mapping = std::exchange(orig.mapping, nullptr);
+        mappedBytes = std::exchange(orig.mappedBytes, 0);
+        items = std::exchange(orig.items, nullptr);
+        len = std::exchange(orig.len, 0);
+    }
+    return *this;
+    
+}
+
+/* Destructor */
+
+template<binary_serializable T>
+MappedList<T>::~MappedList() {
+    unmap();
+}
+
+#endif /* LIST_IO_HAS_MMAP */
+
+#endif /* list_io_hpp */
@@ -0,0 +1,257 @@
+//
+//  list_stats.hpp
+//  linked_list
+//
+//  Opt-in instrumentation for List<T>. Compiled with
+//  -DLINKED_LIST_INSTRUMENTATION, every List counts node allocations,
+//  node_at() walks, O(n) pop_back() scans, calls per operation and the
+//  peak length into process wide counters. Without the macro the hooks
+//  expand to nothing and this header declares nothing.
+//
+
+#ifndef list_stats_hpp
+#define list_stats_hpp
+
+#ifdef LINKED_LIST_INSTRUMENTATION
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iterator>
+#include <iostream>
+#include <ostream>
+
+
+/*************************************************************************/
+/*                                                                       */
+/* ********************************************************************* */
+/* **************************** Declaration **************************** */
+/* ********************************************************************* */
+/*                                                                       */
+/*************************************************************************/
+
+
+/* Operations with a call counter. Calls made by other operations count */
+/* too, e.g. remove(0) counts as remove and as pop_front               */
+
+enum class ListOp : size_t {
+    push_back, push, insert, pop_front, pop_back, remove, at,
+    insert_after, erase_after, splice_after, append, assign, copy,
+    map, fold, filter, remove_if, sort, merge, unique, reverse, clear,
+    count
+};
+
+inline constexpr const char * list_op_names[] = {
+    "push_back", "push", "insert", "pop_front", "pop_back", "remove", "at",
+    "insert_after", "erase_after", "splice_after", "append", "assign", "copy",
+    "map", "fold", "filter", "remove_if", "sort", "merge", "unique", "reverse",
+    "clear"
+};
+
+static_assert(std::size(list_op_names) == size_t(ListOp::count));
+
+/* A plain snapshot of the counters */
+
+struct ListCounters {
+    
+    uint64_t nodesAllocated = 0;
+    uint64_t nodesFreed = 0;
+    uint64_t nodeAtCalls = 0;
+    uint64_t nodeAtHops = 0;
+    uint64_t popBackScans = 0;
+    uint64_t peakLength = 0;
+    std::array<uint64_t, size_t(ListOp::count)> calls { };
+    
+    /* Counts since an earlier snapshot, the peak is kept as is */
+    ListCounters operator-(const ListCounters & since) const;
+    
+};
+
+std::ostream & operator<<(std::ostream & out, const ListCounters & counters);
+
+/* Process wide counters, updated with relaxed atomics so lists on */
+/* different threads can be counted together                      */
+
+class ListStats {
+    
+    std::atomic<uint64_t> nodesAllocated = 0;
+    std::atomic<uint64_t> nodesFreed = 0;
+    std::atomic<uint64_t> nodeAtCalls = 0;
+    std::atomic<uint64_t> nodeAtHops = 0;
+    std::atomic<uint64_t> popBackScans = 0;
+    std::atomic<uint64_t> peakLength = 0;
+    std::array<std::atomic<uint64_t>, size_t(ListOp::count)> calls { };
+    
+public:
+    
+    /* Hooks called by List */
+    
+    void allocated(const uint64_t count);
+    void freed(const uint64_t count);
+    void node_at(const uint64_t hops);
+    void pop_back_scan();
+    void length(const uint64_t len);
+    void call(const ListOp op);
+    
+    /* Reading */
+    
+    ListCounters snapshot() const;
+    void reset();
+    
+};
+
+inline ListStats list_stats;
+
+/* Prints the counters accumulated during its lifetime under label, */
+/* to find which call site takes the O(n) paths                    */
+
+class ListStatsScope {
+    
+    const char * label;
+    std::ostream & out;
+    const ListCounters start;
+    
+public:
+    
+    explicit ListStatsScope(const char * label, std::ostream & out = std::cerr);
+    ListStatsScope(const ListStatsScope &) = delete;
+    ListStatsScope & operator=(const ListStatsScope &) = delete;
+    ~ListStatsScope();
+    
+};
+
+#define LIST_STATS(hook) list_stats.hook
+
+/**************************************************************************/
+/*                                                                        */
+/* ********************************************************************** */
+/* *************************** Implementation *************************** */
+/* ********************************************************************** */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**********************/
+/*    ListCounters    */
+/**********************/
+
+inline ListCounters ListCounters::operator-(const ListCounters & since) const {
+    
+    ListCounters diff = *this;
+    diff.nodesAllocated -= since.nodesAllocated;
+    diff.nodesFreed -= since.nodesFreed;
+    diff.nodeAtCalls -= since.nodeAtCalls;
+    diff.nodeAtHops -= since.nodeAtHops;
+    diff.popBackScans -= since.popBackScans;
+    for (size_t i = 0; i < calls.size(); ++i) {
+        diff.calls[i] -= since.calls[i];
+    }
+    return diff;
+    
+}
+
+inline std::ostream & operator<<(std::ostream & out,
+                                 const ListCounters & counters) {
+    
+    out << std::setw(18) << "nodes allocated" << std::setw(14) << counters.nodesAllocated << "\n"
+        << std::setw(18) << "nodes freed" << std::setw(14) << counters.nodesFreed << "\n"
+        << std::setw(18) << "node_at calls" << std::setw(14) << counters.nodeAtCalls << "\n"
+        << std::setw(18) << "node_at hops" << std::setw(14) << counters.nodeAtHops << "\n"
+        << std::setw(18) << "pop_back scans" << std::setw(14) << counters.popBackScans << "\n"
+        << std::setw(18) << "peak length" << std::setw(14) << counters.peakLength << "\n";
+    
+    for (size_t i = 0; i < counters.calls.size(); ++i) {
+        if (counters.calls[i]) {
+            out << std::setw(18) << list_op_names[i]
+                << std::setw(14) << counters.calls[i] << "\n";
+        }
+    }
+    
+    return out;
+    
+}
+
+
+/**********************/
+/*     ListStats      */
+/**********************/
+
+inline void ListStats::allocated(const uint64_t count) {
+    nodesAllocated.fetch_add(count, std::memory_order_relaxed);
+}
+
+inline void ListStats::freed(const uint64_t count) {
+    nodesFreed.fetch_add(count, std::memory_order_relaxed);
+}
+
+inline void ListStats::node_at(const uint64_t hops) {
+    nodeAtCalls.fetch_add(1, std::memory_order_relaxed);
+    nodeAtHops.fetch_add(hops, std::memory_order_relaxed);
+}
+
+inline void ListStats::pop_back_scan() {
+    popBackScans.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void ListStats::length(const uint64_t len) {
+    uint64_t peak = peakLength.load(std::memory_order_relaxed);
+    while (len > peak and
+           not peakLength.compare_exchange_weak(peak, len,
+                                                std::memory_order_relaxed));
+}
+
+inline void ListStats::call(const ListOp op) {
+    calls[size_t(op)].fetch_add(1, std::memory_order_relaxed);
+}
+
+inline ListCounters ListStats::snapshot() const {
+    
+    ListCounters counters;
+    counters.nodesAllocated = nodesAllocated.load(std::memory_order_relaxed);
+    counters.nodesFreed = nodesFreed.load(std::memory_order_relaxed);
+    counters.nodeAtCalls = nodeAtCalls.load(std::memory_order_relaxed);
+    counters.nodeAtHops = nodeAtHops.load(std::memory_order_relaxed);
+    counters.popBackScans = popBackScans.load(std::memory_order_relaxed);
+    counters.peakLength = peakLength.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < calls.size(); ++i) {
+        counters.calls[i] = calls[i].load(std::memory_order_relaxed);
+    }
+    return counters;
+    
+}
+
+inline void ListStats::reset() {
+    
+    nodesAllocated.store(0, std::memory_order_relaxed);
+    nodesFreed.store(0, std::memory_order_relaxed);
+    nodeAtCalls.store(0, std::memory_order_relaxed);
+    nodeAtHops.store(0, std::memory_order_relaxed);
+    popBackScans.store(0, std::memory_order_relaxed);
+    peakLength.store(0, std::memory_order_relaxed);
+    for (auto & counter : calls) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    
+}
+
+
+/**********************/
+/*   ListStatsScope   */
+/**********************/
+
+inline ListStatsScope::ListStatsScope(const char * label, std::ostream & out)
+    : label(label), out(out), start(list_stats.snapshot()) { }
+
+inline ListStatsScope::~ListStatsScope() {
+    out << label << ":\n" << (list_stats.snapshot() - start) << std::flush;
+}
+
+#else
+
+#define LIST_STATS(hook) ((void)0)
+
+#endif /* LINKED_LIST_INSTRUMENTATION */
+
+#endif /* list_stats_hpp */
@@ -0,0 +1,141 @@
+//
+//  list_views.hpp
+//  linked_list
+//
+//  Lazy pipelines over List<T>. List is a std::ranges::forward_range, so
+//  the C++20 views (filter, transform, take, ...) chain over it without
+//  building intermediate lists. This header adds the two ends such chains
+//  need: fold(), which consumes a range in the same traversal, and
+//  to_list(), which materializes a range into a List only when asked to.
+//
+//      const int sum = list | std::views::filter(isEven)
+//                           | std::views::transform(square)
+//                           | fold(add, 0);
+//
+
+#ifndef list_views_hpp
+#define list_views_hpp
+
+#include <ranges>
+#include <memory>
+#include <functional>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
+#include "list.hpp"
+
+
+/*************************************************************************/
+/*                                                                       */
+/* ********************************************************************* */
+/* **************************** Declaration **************************** */
+/* ********************************************************************* */
+/*                                                                       */
+/*************************************************************************/
+
+
+static_assert(std::ranges::forward_range<List<int>>);
+static_assert(std::ranges::forward_range<const List<int>>);
+
+/* range | to_list() collects into a List<range_value_t<range>> with */
+/* std::allocator, range | to_list(alloc) uses alloc rebound to the  */
+/* value type                                                        */
+
+template<typename Alloc>
+struct ToList {
+    
+    [[no_unique_address]] Alloc alloc;
+    
+};
+
+ToList<std::allocator<void>> to_list();
+
+template<typename Alloc>
+ToList<Alloc> to_list(const Alloc & alloc);
+
+template<std::ranges::input_range R, typename Alloc,
+         typename T = std::ranges::range_value_t<R>>
+requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+List<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>
+operator|(R && range, const ToList<Alloc> & collector);
+
+/* range | fold(fun, initVal) folds like List::fold, fun(Acc &, elem) */
+/* is called for every element in order                               */
+
+template<typename Acc, typename Fun>
+struct Fold {
+    
+    Fun fun;
+    Acc initVal;
+    
+};
+
+template<typename Acc, typename Fun>
+Fold<Acc, Fun> fold(Fun fun, Acc initVal);
+
+template<std::ranges::input_range R, typename Acc, typename Fun>
+requires std::invocable<Fun &, Acc &, std::ranges::range_reference_t<R>>
+Acc operator|(R && range, Fold<Acc, Fun> folder);
+
+/**************************************************************************/
+/*                                                                        */
+/* ********************************************************************** */
+/* *************************** Implementation *************************** */
+/* ********************************************************************** */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**********************/
+/*      to_list       */
+/**********************/
+
+inline ToList<std::allocator<void>> to_list() {
+    return { };
+}
+
+template<typename Alloc>
+ToList<Alloc> to_list(const Alloc & alloc) {
+    return { alloc };
+}
+
+template<std::ranges::input_range R, typename Alloc, typename T>
+requires std::constructible_from<T, std::ranges::range_reference_t<R>>
+List<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>
+operator|(R && range, const ToList<Alloc> & collector) {
+    
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<T>
+        list_allocator;
+    
+    List<T, list_allocator> list{list_allocator(collector.alloc)};
+    for (auto && elem : range) {
+        list.emplace_back(std::forward<decltype(elem)>(elem));
+    }
+    return list;
+    
+}
+
+
+/**********************/
+/*        fold        */
+/**********************/
+
+template<typename Acc, typename Fun>
+Fold<Acc, Fun> fold(Fun fun, Acc initVal) {
+    return { std::move(fun), std::move(initVal) };
+}
+
+template<std::ranges::input_range R, typename Acc, typename Fun>
+requires std::invocable<Fun &, Acc &, std::ranges::range_reference_t<R>>
+Acc operator|(R && range, Fold<Acc, Fun> folder) {
+    
+    for (auto && elem : range) {
+        std::invoke(folder.fun, folder.initVal,
+                    std::forward<decltype(elem)>(elem));
+    }
+    return std::move(folder.initVal);
+    
+}
+
+#endif /* list_views_hpp */
@@ -232,7 +232,7 @@ void listTest() {
     
 }
 
-int main(int argc, const char * argv[]) {
+int main() {
     const int i = 0;
     print("Hello", ' ', "World", ' ', i, '\n');
     listTest();
@@ -0,0 +1,305 @@
+//
+//  mpsc_queue.hpp
+//  linked_list
+//
+//  Lock-free multi-producer single-consumer queue (Vyukov's intrusive MPSC
+//  queue). Producers link a node with one atomic exchange, the consumer
+//  pops without any atomic read-modify-write. Nodes use the same Link/Node
+//  split and allocator rebinding as List<T>, with an atomic next link.
+//
+
+#ifndef mpsc_queue_hpp
+#define mpsc_queue_hpp
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <cstddef>
+#include <utility>
+
+#include "list.hpp"
+
+
+/*************************************************************************/
+/*                                                                       */
+/* ********************************************************************* */
+/* **************************** Declaration **************************** */
+/* ********************************************************************* */
+/*                                                                       */
+/*************************************************************************/
+
+
+/* push() and emplace() may be called from any number of threads, try_pop(), */
+/* drain_into() and empty() from one consumer thread at a time. Producers  */
+/* allocate the nodes and the consumer deallocates them, so the allocator  */
+/* must accept frees from another thread than the one that allocated       */
+
+template <typename T, typename Alloc = std::allocator<T>>
+class MPSCQueue {
+    
+    struct Link {
+        
+        std::atomic<Link *> next = nullptr;
+        
+    };
+    
+    struct Node : Link {
+        
+        T item;
+        
+        template<typename... args>
+        Node(std::in_place_t, args&&... a);
+        
+    };
+    
+    typedef Link* link_ptr;
+    typedef Node* node_ptr;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Node>
+        node_allocator;
+    typedef std::allocator_traits<node_allocator> node_traits;
+    
+    /* Producers exchange head, the consumer walks from tail. Separate */
+    /* cache lines keep producers from invalidating the consumer's line */
+    
+    alignas(64) std::atomic<link_ptr> head;
+    alignas(64) link_ptr tail;
+    Link stub;
+    [[no_unique_address]] node_allocator alloc;
+    
+    /* Node allocation */
+    
+    template<typename... args>
+    node_ptr create_node(args&&... a);
+    void destroy_node(node_ptr node);
+    
+    /* Linking */
+    
+    void push_link(link_ptr link);
+    node_ptr pop_node();
+    
+public:
+    
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    
+    /* Producer side */
+    
+    void push(const T & item);
+    void push(T && item);
+    
+    template<typename... args>
+    void emplace(args&&... a);
+    
+    /* Consumer side */
+    
+    std::optional<T> try_pop();
+    
+    template<typename ListAlloc>
+    size_t drain_into(List<T, ListAlloc> & list);
+    
+    bool empty() const;
+    
+    /* Constructors */
+    
+    MPSCQueue();
+    explicit MPSCQueue(const Alloc & allocator);
+    MPSCQueue(const MPSCQueue<T, Alloc> &) = delete;
+    MPSCQueue<T, Alloc> & operator=(const MPSCQueue<T, Alloc> &) = delete;
+    
+    /* Destructor */
+    
+    ~MPSCQueue();
+    
+};
+
+/**************************************************************************/
+/*                                                                        */
+/* ********************************************************************** */
+/* *************************** Implementation *************************** */
+/* ********************************************************************** */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**********************/
+/*        Node        */
+/**********************/
+
+template<typename T, typename Alloc>
+template<typename... args>
+MPSCQueue<T, Alloc>::Node::Node(std::in_place_t, args&&... a)
+    : item(std::forward<args>(a)...) { }
+
+
+/**********************/
+/*      Internal      */
+/**********************/
+
+/* Node allocation */
+
+template<typename T, typename Alloc>
+template<typename... args>
+typename MPSCQueue<T, Alloc>::node_ptr
+MPSCQueue<T, Alloc>::create_node(args&&... a) {
+    
+    node_ptr node = node_traits::allocate(alloc, 1);
+    try {
+        node_traits::construct(alloc, node, std::in_place,
+                              std::forward<args>(a)...);
+    } catch (...) {
+        node_traits::deallocate(alloc, node, 1);
+        throw;
+    }
+    return node;
+    
+}
+
+template<typename T, typename Alloc>
+void MPSCQueue<T, Alloc>::destroy_node(node_ptr node) {
+    node_traits::destroy(alloc, node);
+    node_traits::deallocate(alloc, node, 1);
+}
+
+/* Linking */
+
+template<typename T, typename Alloc>
+void MPSCQueue<T, Alloc>::push_link(link_ptr link) {
+    
+    link->next.store(nullptr, std::memory_order_relaxed);
+    
+    /* Between the exchange and the store the queue is briefly split,  */
+    /* the consumer sees that as empty until prev->next is published   */
+    
+    link_ptr prev = head.exchange(link, std::memory_order_acq_rel);
+    prev->next.store(link, std::memory_order_release);
+    
+}
+
+template<typename T, typename Alloc>
+typename MPSCQueue<T, Alloc>::node_ptr MPSCQueue<T, Alloc>::pop_node() {
+    
+    link_ptr first = tail;
+    link_ptr next = first->next.load(std::memory_order_acquire);
+    
+    /* Skip the stub, it carries no item */
+    
+    if (first == &stub) {
+        if (next == nullptr) {
+            return nullptr;
+        }
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    
+    if (next != nullptr) {
+        tail = next;
+        return static_cast<node_ptr>(first);
+    }
+    
+    /* first is the last linked node. Unless a producer is mid push, put */
+    /* the stub behind it so first can be handed out without emptying  */
+    /* the chain                                                       */
+    
+    if (first != head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    
+    push_link(&stub);
+    next = first->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+        tail = next;
+        return static_cast<node_ptr>(first);
+    }
+    
+    return nullptr;
+    
+}
+
+
+/**********************/
+/*       Public       */
+/**********************/
+
+/* Producer side */
+
+template<typename T, typename Alloc>
+void MPSCQueue<T, Alloc>::push(const T & item) {
+    push_link(create_node(item));
+}
+
+template<typename T, typename Alloc>
+void MPSCQueue<T, Alloc>::push(T && item) {
+    push_link(create_node(std::move(item)));
+}
+
+template<typename T, typename Alloc>
+template<typename... args>
+void MPSCQueue<T, Alloc>::emplace(args&&... a) {
+    push_link(create_node(std::forward<args>(a)...));
+}
+
+/* Consumer side */
+
+template<typename T, typename Alloc>
+std::optional<T> MPSCQueue<T, Alloc>::try_pop() {
+    
+    node_ptr node = pop_node();
+    if (node == nullptr) {
+        return std::nullopt;
+    }
+    
+    std::optional<T> retval(std::move(node->item));
+    destroy_node(node);
+    return retval;
+    
+}
+
+/* Moves every item that is fully published into list, returns the count */
+
+template<typename T, typename Alloc>
+template<typename ListAlloc>
+size_t MPSCQueue<T, Alloc>::drain_into(List<T, ListAlloc> & list) {
+    
+    size_t count = 0;
+    
+    for (node_ptr node = pop_node(); node != nullptr; node = pop_node()) {
+        try {
+            list.push_back(std::move(node->item));
+        } catch (...) {
+            destroy_node(node);
+            throw;
+        }
+        destroy_node(node);
+        ++count;
+    }
+    
+    return count;
+    
+}
+
+template<typename T, typename Alloc>
+bool MPSCQueue<T, Alloc>::empty() const {
+    return tail == &stub and
+           stub.next.load(std::memory_order_acquire) == nullptr;
+}
+
+/* Constructors */
+
+template<typename T, typename Alloc>
+MPSCQueue<T, Alloc>::MPSCQueue() : head(&stub), tail(&stub) { }
+
+template<typename T, typename Alloc>
+MPSCQueue<T, Alloc>::MPSCQueue(const Alloc & allocator)
+    : head(&stub), tail(&stub), alloc(allocator) { }
+
+/* Destructor */
+
+template<typename T, typename Alloc>
+MPSCQueue<T, Alloc>::~MPSCQueue() {
+    for (node_ptr node = pop_node(); node != nullptr; node = pop_node()) {
+        destroy_node(node);
+    }
+}
+
+#endif /* mpsc_queue_hpp */
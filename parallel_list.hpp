@@ -0,0 +1,300 @@
+//
+//  parallel_list.hpp
+//  linked_list
+//
+//  Parallel map/fold/filter for List<T, Alloc>. The list is cut into one
+//  chunk per thread in a single pass, each chunk is processed on its own
+//  std::thread into a private List, and the per-chunk results are joined
+//  in order, spliced in O(1) each when the allocator allows it.
+//
+
+#ifndef parallel_list_hpp
+#define parallel_list_hpp
+
+#include <thread>
+#include <algorithm>
+#include <vector>
+#include <exception>
+#include <memory>
+#include <functional>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "list.hpp"
+
+
+/*************************************************************************/
+/*                                                                       */
+/* ********************************************************************* */
+/* **************************** Declaration **************************** */
+/* ********************************************************************* */
+/*                                                                       */
+/*************************************************************************/
+
+
+/* Lists shorter than this per thread are not worth another thread */
+
+inline constexpr size_t par_min_chunk = 1024;
+
+/* fun is called concurrently from several threads, threads == 0 uses  */
+/* std::thread::hardware_concurrency(). Workers allocate result nodes  */
+/* themselves only with always equal allocators, which must then be   */
+/* thread safe. Others (PoolAllocator, ArenaAllocator) may share state */
+/* between copies, so the chunks are built with std::allocator and    */
+/* moved into the caller's allocator on the calling thread            */
+
+template<typename T, typename Alloc, typename Fun,
+         typename U = std::remove_cvref_t<
+             std::invoke_result_t<Fun &, const T &>>>
+requires std::invocable<Fun &, const T &>
+List<U, typename std::allocator_traits<Alloc>::template rebind_alloc<U>>
+par_map(const List<T, Alloc> & list, Fun fun, size_t threads = 0);
+
+/* Each chunk folds from its own copy of initVal, the chunk results are */
+/* then combined left to right, so initVal must be an identity of the */
+/* associative combine(Acc &, const Acc &). fun is called concurrently */
+
+template<typename T, typename Alloc, typename Acc, typename Fun, typename Combine>
+requires std::invocable<Fun &, Acc &, const T &> and
+         std::invocable<Combine &, Acc &, const Acc &>
+Acc par_fold(const List<T, Alloc> & list,
+             Fun fun,
+             Acc initVal,
+             Combine combine,
+             size_t threads = 0);
+
+/* Allocates like par_map */
+
+template<typename T, typename Alloc, typename Fun>
+requires std::predicate<Fun &, const T &>
+List<T, Alloc> par_filter(const List<T, Alloc> & list,
+                          Fun fun,
+                          size_t threads = 0);
+
+/**************************************************************************/
+/*                                                                        */
+/* ********************************************************************** */
+/* *************************** Implementation *************************** */
+/* ********************************************************************** */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**********************/
+/*      Internal      */
+/**********************/
+
+/* Chunk boundaries, chunk i is [bounds[i], bounds[i + 1]) */
+
+template<typename T, typename Alloc>
+std::vector<typename List<T, Alloc>::const_iterator>
+par_split(const List<T, Alloc> & list, size_t threads) {
+    
+    if (threads == 0) {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    const size_t chunks =
+        std::max<size_t>(std::min(threads, list.size() / par_min_chunk), 1);
+    
+    std::vector<typename List<T, Alloc>::const_iterator> bounds;
+    bounds.reserve(chunks + 1);
+    
+    auto it = list.cbegin();
+    for (size_t i = 0; i < chunks; ++i) {
+        bounds.push_back(it);
+        const size_t count = list.size() / chunks + (i < list.size() % chunks);
+        for (size_t j = 0; j < count; ++j) {
+            ++it;
+        }
+    }
+    bounds.push_back(it);
+    
+    return bounds;
+    
+}
+
+/* Allocator of the per-chunk lists the workers fill */
+
+template<typename Alloc>
+using par_chunk_allocator =
+    std::conditional_t<std::allocator_traits<Alloc>::is_always_equal::value,
+                       Alloc,
+                       std::allocator<typename Alloc::value_type>>;
+
+/* Chunk lists for the workers, empty and ready to be filled */
+
+template<typename T, typename Alloc>
+std::vector<List<T, par_chunk_allocator<Alloc>>>
+par_parts(const size_t chunks, const Alloc & alloc) {
+    
+    std::vector<List<T, par_chunk_allocator<Alloc>>> parts;
+    parts.reserve(chunks);
+    for (size_t i = 0; i < chunks; ++i) {
+        if constexpr (std::is_same_v<par_chunk_allocator<Alloc>, Alloc>) {
+            parts.emplace_back(alloc);
+        } else {
+            parts.emplace_back();
+        }
+    }
+    return parts;
+    
+}
+
+/* Joins the chunk results in order, splicing when they already use */
+/* alloc and moving the items over otherwise                        */
+
+template<typename T, typename Alloc, typename ChunkAlloc>
+List<T, Alloc> par_gather(std::vector<List<T, ChunkAlloc>> & parts,
+                          const Alloc & alloc) {
+    
+    if constexpr (std::is_same_v<ChunkAlloc, Alloc>) {
+        for (size_t i = 1; i < parts.size(); ++i) {
+            parts[0] += std::move(parts[i]);
+        }
+        return std::move(parts[0]);
+    } else {
+        List<T, Alloc> result(alloc);
+        for (List<T, ChunkAlloc> & part : parts) {
+            for (T & item : part) {
+                result.push_back(std::move(item));
+            }
+            part.clear();
+        }
+        return result;
+    }
+    
+}
+
+/* Runs work(i) for every chunk, chunk 0 on the calling thread. The */
+/* first exception thrown by any chunk is rethrown after the join,  */
+/* and if a thread cannot be started the ones already running are   */
+/* joined before the error propagates                               */
+
+template<typename Work>
+void par_run(const size_t chunks, Work & work) {
+    
+    std::vector<std::exception_ptr> errors(chunks);
+    std::vector<std::thread> threads;
+    threads.reserve(chunks - 1);
+    
+    const auto guarded = [&work, &errors](const size_t i) {
+        try {
+            work(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+    
+    const auto join = [&threads]() {
+        for (std::thread & t : threads) {
+            t.join();
+        }
+    };
+    
+    try {
+        for (size_t i = 1; i < chunks; ++i) {
+            threads.emplace_back(guarded, i);
+        }
+    } catch (...) {
+        join();
+        throw;
+    }
+    guarded(0);
+    join();
+    
+    for (const std::exception_ptr & error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    
+}
+
+
+/**********************/
+/*       Public       */
+/**********************/
+
+template<typename T, typename Alloc, typename Fun, typename U>
+requires std::invocable<Fun &, const T &>
+List<U, typename std::allocator_traits<Alloc>::template rebind_alloc<U>>
+par_map(const List<T, Alloc> & list, Fun fun, size_t threads) {
+    
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<U>
+        result_allocator;
+    
+    const auto bounds = par_split(list, threads);
+    const size_t chunks = bounds.size() - 1;
+    const result_allocator alloc(list.get_allocator());
+    
+    auto parts = par_parts<U>(chunks, alloc);
+    
+    auto work = [&](const size_t i) {
+        for (auto it = bounds[i]; it != bounds[i + 1]; ++it) {
+            parts[i].push_back(std::invoke(fun, *it));
+        }
+    };
+    par_run(chunks, work);
+    
+    return par_gather(parts, alloc);
+    
+}
+
+template<typename T, typename Alloc, typename Acc, typename Fun, typename Combine>
+requires std::invocable<Fun &, Acc &, const T &> and
+         std::invocable<Combine &, Acc &, const Acc &>
+Acc par_fold(const List<T, Alloc> & list,
+             Fun fun,
+             Acc initVal,
+             Combine combine,
+             size_t threads) {
+    
+    const auto bounds = par_split(list, threads);
+    const size_t chunks = bounds.size() - 1;
+    
+    /* One cache line per accumulator, so threads don't false share */
+    
+    struct alignas(64) Slot {
+        Acc value;
+    };
+    std::vector<Slot> parts(chunks, Slot { initVal });
+    
+    auto work = [&](const size_t i) {
+        for (auto it = bounds[i]; it != bounds[i + 1]; ++it) {
+            std::invoke(fun, parts[i].value, *it);
+        }
+    };
+    par_run(chunks, work);
+    
+    for (size_t i = 1; i < chunks; ++i) {
+        std::invoke(combine, parts[0].value, std::as_const(parts[i].value));
+    }
+    return std::move(parts[0].value);
+    
+}
+
+template<typename T, typename Alloc, typename Fun>
+requires std::predicate<Fun &, const T &>
+List<T, Alloc> par_filter(const List<T, Alloc> & list, Fun fun, size_t threads) {
+    
+    const auto bounds = par_split(list, threads);
+    const size_t chunks = bounds.size() - 1;
+    
+    auto parts = par_parts<T>(chunks, list.get_allocator());
+    
+    auto work = [&](const size_t i) {
+        for (auto it = bounds[i]; it != bounds[i + 1]; ++it) {
+            if (std::invoke(fun, *it)) {
+                parts[i].push_back(*it);
+            }
+        }
+    };
+    par_run(chunks, work);
+    
+    return par_gather(parts, list.get_allocator());
+    
+}
+
+#endif /* parallel_list_hpp */
@@ -0,0 +1,305 @@
+//
+//  pool_allocator.hpp
+//  linked_list
+//
+//  Slab/free-list node pool for List<T, Alloc>. Nodes are carved out of
+//  contiguous chunks and freed nodes are recycled through a free list, so
+//  push/pop churn does not hit malloc/free.
+//
+
+#ifndef pool_allocator_hpp
+#define pool_allocator_hpp
+
+#include <memory>
+#include <new>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "list.hpp"
+
+
+/*************************************************************************/
+/*                                                                       */
+/* ********************************************************************* */
+/* **************************** Declaration **************************** */
+/* ********************************************************************* */
+/*                                                                       */
+/*************************************************************************/
+
+
+/* Fixed block size pool, allocates blocks from chunks of blocksPerChunk */
+
+class NodePool {
+    
+    struct FreeBlock {
+        FreeBlock * next;
+    };
+    
+    struct Chunk {
+        Chunk * next;
+    };
+    
+    const size_t blockSize;
+    const size_t alignment;
+    const size_t blocksPerChunk;
+    const size_t headerSize;
+    
+    FreeBlock * freeList = nullptr;
+    Chunk * chunks = nullptr;
+    std::byte * bump = nullptr;
+    std::byte * bumpEnd = nullptr;
+    
+    void allocate_chunk();
+    
+public:
+    
+    static size_t block_alignment_for(const size_t align);
+    static size_t block_size_for(const size_t size, const size_t align);
+    
+    NodePool(const size_t size, const size_t align, const size_t perChunk);
+    NodePool(const NodePool &) = delete;
+    NodePool & operator=(const NodePool &) = delete;
+    ~NodePool();
+    
+    void * allocate();
+    void deallocate(void * block) noexcept;
+    
+    size_t block_size() const;
+    size_t block_alignment() const;
+    
+};
+
+/* Owns one NodePool per block size, shared by all rebound allocators */
+
+class NodePoolResource {
+    
+    const size_t blocksPerChunk;
+    std::vector<std::unique_ptr<NodePool>> pools;
+    
+public:
+    
+    explicit NodePoolResource(const size_t perChunk = 256);
+    NodePoolResource(const NodePoolResource &) = delete;
+    NodePoolResource & operator=(const NodePoolResource &) = delete;
+    
+    NodePool & pool_for(const size_t size, const size_t align);
+    
+};
+
+/* std::allocator compatible front end, single objects come from the pool */
+
+template<typename T>
+class PoolAllocator {
+    
+    template<typename> friend class PoolAllocator;
+    
+    std::shared_ptr<NodePoolResource> resource;
+    NodePool * pool;
+    
+public:
+    
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+    
+    PoolAllocator();
+    explicit PoolAllocator(std::shared_ptr<NodePoolResource> res);
+    
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U> & other);
+    
+    T * allocate(const size_t n);
+    void deallocate(T * ptr, const size_t n) noexcept;
+    
+    size_t max_size() const noexcept;
+    
+    template<typename U>
+    bool operator==(const PoolAllocator<U> & other) const;
+    
+};
+
+template<typename T>
+using PooledList = List<T, PoolAllocator<T>>;
+
+/**************************************************************************/
+/*                                                                        */
+/* ********************************************************************** */
+/* *************************** Implementation *************************** */
+/* ********************************************************************** */
+/*                                                                        */
+/**************************************************************************/
+
+
+/********************************************************************/
+/*                                                                  */
+/*                             NodePool                             */
+/*                                                                  */
+/********************************************************************/
+
+inline NodePool::NodePool(const size_t size,
+                          const size_t align,
+                          const size_t perChunk)
+    : blockSize(block_size_for(size, align)),
+      alignment(block_alignment_for(align)),
+      blocksPerChunk(perChunk ? perChunk : 1),
+      headerSize(((sizeof(Chunk) + alignment - 1) / alignment) * alignment) { }
+
+inline size_t NodePool::block_alignment_for(const size_t align) {
+    return std::max(align, alignof(FreeBlock));
+}
+
+inline size_t NodePool::block_size_for(const size_t size, const size_t align) {
+    const size_t a = block_alignment_for(align);
+    return ((std::max(size, sizeof(FreeBlock)) + a - 1) / a) * a;
+}
+
+inline NodePool::~NodePool() {
+    
+    while (chunks != nullptr) {
+        Chunk * next = chunks->next;
+        ::operator delete(chunks, std::align_val_t(alignment));
+        chunks = next;
+    }
+    
+}
+
+inline void NodePool::allocate_chunk() {
+    
+    const size_t bytes = headerSize + blockSize * blocksPerChunk;
+    void * memory = ::operator new(bytes, std::align_val_t(alignment));
+    
+    Chunk * chunk = static_cast<Chunk *>(memory);
+    chunk->next = chunks;
+    chunks = chunk;
+    
+    bump = static_cast<std::byte *>(memory) + headerSize;
+    bumpEnd = bump + blockSize * blocksPerChunk;
+    
+}
+
+inline void * NodePool::allocate() {
+    
+    if (freeList != nullptr) {
+        FreeBlock * block = freeList;
+        freeList = block->next;
+        return block;
+    }
+    
+    if (bump == bumpEnd) {
+        allocate_chunk();
+    }
+    
+    void * block = bump;
+    bump += blockSize;
+    return block;
+    
+}
+
+inline void NodePool::deallocate(void * block) noexcept {
+    FreeBlock * freed = static_cast<FreeBlock *>(block);
+    freed->next = freeList;
+    freeList = freed;
+}
+
+inline size_t NodePool::block_size() const {
+    return blockSize;
+}
+
+inline size_t NodePool::block_alignment() const {
+    return alignment;
+}
+
+
+/********************************************************************/
+/*                                                                  */
+/*                         NodePoolResource                         */
+/*                                                                  */
+/********************************************************************/
+
+inline NodePoolResource::NodePoolResource(const size_t perChunk)
+    : blocksPerChunk(perChunk) { }
+
+inline NodePool & NodePoolResource::pool_for(const size_t size,
+                                             const size_t align) {
+    
+    const size_t blockSize = NodePool::block_size_for(size, align);
+    const size_t alignment = NodePool::block_alignment_for(align);
+    
+    for (const auto & pool : pools) {
+        if (pool->block_size() == blockSize and
+            pool->block_alignment() == alignment) {
+            return *pool;
+        }
+    }
+    
+    pools.push_back(std::make_unique<NodePool>(size, align, blocksPerChunk));
+    return *pools.back();
+    
+}
+
+
+/********************************************************************/
+/*                                                                  */
+/*                          PoolAllocator                           */
+/*                                                                  */
+/********************************************************************/
+
+template<typename T>
+PoolAllocator<T>::PoolAllocator()
+    : PoolAllocator(std::make_shared<NodePoolResource>()) { }
+
+template<typename T>
+PoolAllocator<T>::PoolAllocator(std::shared_ptr<NodePoolResource> res)
+    : resource(std::move(res)),
+      pool(&resource->pool_for(sizeof(T), alignof(T))) { }
+
+template<typename T>
+template<typename U>
+PoolAllocator<T>::PoolAllocator(const PoolAllocator<U> & other)
+    : resource(other.resource),
+      pool(&resource->pool_for(sizeof(T), alignof(T))) { }
+
+template<typename T>
+T * PoolAllocator<T>::allocate(const size_t n) {
+    
+    if (n == 1) {
+        return static_cast<T *>(pool->allocate());
+    }
+    if (n > max_size()) {
+        throw std::bad_array_new_length();
+    }
+    
+    return static_cast<T *>(::operator new(n * sizeof(T),
+                                           std::align_val_t(alignof(T))));
+    
+}
+
+template<typename T>
+void PoolAllocator<T>::deallocate(T * ptr, const size_t n) noexcept {
+    
+    if (n == 1) {
+        pool->deallocate(ptr);
+        return;
+    }
+    
+    ::operator delete(ptr, std::align_val_t(alignof(T)));
+    
+}
+
+template<typename T>
+size_t PoolAllocator<T>::max_size() const noexcept {
+    return std::numeric_limits<size_t>::max() / sizeof(T);
+}
+
+template<typename T>
+template<typename U>
+bool PoolAllocator<T>::operator==(const PoolAllocator<U> & other) const {
+    return resource == other.resource;
+}
+
+#endif /* pool_allocator_hpp */
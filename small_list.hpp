@@ -0,0 +1,166 @@
+//
+//  small_list.hpp
+//  linked_list
+//
+//  Small-buffer node allocator for List<T, Alloc>. InlineAllocator<T, N>
+//  carries storage for N nodes inside itself, and List keeps its allocator
+//  inside the List object, so SmallList<T, N> holds its first N nodes
+//  inline and only goes to the heap for the ones beyond that.
+//
+
+#ifndef small_list_hpp
+#define small_list_hpp
+
+#include <memory>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include "list.hpp"
+
+
+/*************************************************************************/
+/*                                                                       */
+/* ********************************************************************* */
+/* **************************** Declaration **************************** */
+/* ********************************************************************* */
+/*                                                                       */
+/*************************************************************************/
+
+
+/* Every copy of the allocator starts with empty storage of its own and */
+/* compares equal only to itself, so nodes never change owners. Meant  */
+/* for List only, which moves items instead of nodes between such      */
+/* allocators (see allocator_stores_nodes_inline)                      */
+
+template<typename T, size_t N>
+class InlineAllocator {
+    
+    static_assert(N > 0, "InlineAllocator needs room for at least one node");
+    
+    /* Freed slots are chained through their own storage */
+    
+    union Slot {
+        Slot * next;
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+    
+    Slot slots[N];
+    Slot * freeSlots = nullptr;
+    size_t used = 0;
+    
+    bool owns(const T * ptr) const;
+    
+public:
+    
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::false_type propagate_on_container_move_assignment;
+    typedef std::false_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+    
+    template<typename U>
+    struct rebind {
+        typedef InlineAllocator<U, N> other;
+    };
+    
+    InlineAllocator() noexcept;
+    InlineAllocator(const InlineAllocator<T, N> &) noexcept;
+    
+    template<typename U>
+    InlineAllocator(const InlineAllocator<U, N> &) noexcept;
+    
+    /* Keeps its own storage, the nodes in it are still in use */
+    
+    InlineAllocator<T, N> & operator=(const InlineAllocator<T, N> &) noexcept;
+    
+    /* Single nodes come from the inline slots while any are free, */
+    /* everything else from the heap                               */
+    
+    T * allocate(const size_t n);
+    void deallocate(T * ptr, const size_t n) noexcept;
+    
+    template<typename U>
+    bool operator==(const InlineAllocator<U, N> & other) const;
+    
+};
+
+template<typename T, size_t N>
+struct allocator_stores_nodes_inline<InlineAllocator<T, N>> : std::true_type { };
+
+/* N defaults to the short lists most code creates */
+
+template<typename T, size_t N = 8>
+using SmallList = List<T, InlineAllocator<T, N>>;
+
+/**************************************************************************/
+/*                                                                        */
+/* ********************************************************************** */
+/* *************************** Implementation *************************** */
+/* ********************************************************************** */
+/*                                                                        */
+/**************************************************************************/
+
+
+template<typename T, size_t N>
+bool InlineAllocator<T, N>::owns(const T * ptr) const {
+    const void * p = ptr;
+    return not std::less<const void *>()(p, slots) and
+           std::less<const void *>()(p, slots + N);
+}
+
+template<typename T, size_t N>
+InlineAllocator<T, N>::InlineAllocator() noexcept { }
+
+template<typename T, size_t N>
+InlineAllocator<T, N>::InlineAllocator(const InlineAllocator<T, N> &) noexcept { }
+
+template<typename T, size_t N>
+template<typename U>
+InlineAllocator<T, N>::InlineAllocator(const InlineAllocator<U, N> &) noexcept { }
+
+template<typename T, size_t N>
+InlineAllocator<T, N> &
+InlineAllocator<T, N>::operator=(const InlineAllocator<T, N> &) noexcept {
+    return *this;
+}
+
+template<typename T, size_t N>
+T * InlineAllocator<T, N>::allocate(const size_t n) {
+    
+    if (n == 1) {
+        if (freeSlots != nullptr) {
+            Slot * slot = freeSlots;
+            freeSlots = slot->next;
+            return reinterpret_cast<T *>(slot->bytes);
+        }
+        if (used < N) {
+            return reinterpret_cast<T *>(slots[used++].bytes);
+        }
+    }
+    
+    return std::allocator<T>().allocate(n);
+    
+}
+
+template<typename T, size_t N>
+void InlineAllocator<T, N>::deallocate(T * ptr, const size_t n) noexcept {
+    
+    if (not owns(ptr)) {
+        std::allocator<T>().deallocate(ptr, n);
+        return;
+    }
+    
+    Slot * slot = reinterpret_cast<Slot *>(ptr);
+    slot->next = freeSlots;
+    freeSlots = slot;
+    
+}
+
+template<typename T, size_t N>
+template<typename U>
+bool InlineAllocator<T, N>::operator==(const InlineAllocator<U, N> & other) const {
+    return static_cast<const void *>(this) == static_cast<const void *>(&other);
+}
+
+#endif /* small_list_hpp */
@@ -0,0 +1,254 @@
+//
+//  arena_allocator_test.cpp
+//  linked_list
+//
+//  Tests for ArenaAllocator and ArenaList. CountingArena is an
+//  ArenaAllocator that also counts the per-node destroy and deallocate
+//  calls the containers make, so the tests can check that clearing or
+//  destroying a list of trivially destructible items touches no node,
+//  while items with destructors still get them run.
+//
+//  Build: cmake --build <build dir> --target arena_allocator_test && ctest
+//
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "list.hpp"
+#include "dlist.hpp"
+#include "unrolled_list.hpp"
+#include "arena_allocator.hpp"
+#include "check.hpp"
+
+/* Counts what the arena asks its upstream for */
+
+class CountingResource : public std::pmr::memory_resource {
+    
+    void * do_allocate(const size_t bytes, const size_t align) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    
+    void do_deallocate(void * ptr, const size_t bytes, const size_t align) override {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, align);
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override {
+        return this == &other;
+    }
+    
+public:
+    
+    size_t allocations = 0;
+    
+};
+
+struct ArenaCounters {
+    size_t destroyed = 0;
+    size_t deallocated = 0;
+};
+
+template<typename T>
+class CountingArena : public ArenaAllocator<T> {
+    
+    template<typename> friend class CountingArena;
+    
+    ArenaCounters * counters;
+    
+public:
+    
+    typedef T value_type;
+    
+    CountingArena(std::pmr::monotonic_buffer_resource & arena, ArenaCounters & c)
+        : ArenaAllocator<T>(arena), counters(&c) { }
+    
+    template<typename U>
+    CountingArena(const CountingArena<U> & other)
+        : ArenaAllocator<T>(other), counters(other.counters) { }
+    
+    void deallocate(T * ptr, const size_t n) noexcept {
+        ++counters->deallocated;
+        ArenaAllocator<T>::deallocate(ptr, n);
+    }
+    
+    template<typename U>
+    void destroy(U * ptr) {
+        ++counters->destroyed;
+        ptr->~U();
+    }
+    
+};
+
+template<typename T>
+struct allocator_releases_in_bulk<CountingArena<T>> : std::true_type { };
+
+static_assert(allocator_releases_in_bulk<ArenaAllocator<int>>::value);
+
+/* Counts its own destructor calls */
+
+struct Tracked {
+    
+    static size_t destructed;
+    int value = 0;
+    
+    Tracked(const int v) : value(v) { }
+    Tracked(const Tracked & other) = default;
+    ~Tracked() {
+        ++destructed;
+    }
+    
+};
+
+size_t Tracked::destructed = 0;
+
+/* Fills any of the containers through push_back */
+
+template<typename L>
+L filled(const typename L::allocator_type & allocator, const int count) {
+    L list(allocator);
+    for (int i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+    return list;
+}
+
+
+/********************************************************************/
+/*                                                                  */
+/*                              Tests                               */
+/*                                                                  */
+/********************************************************************/
+
+template<typename L>
+void trivialClearTest() {
+    
+    std::pmr::monotonic_buffer_resource arena;
+    ArenaCounters c;
+    ArenaCounters popped;
+    {
+        L list = filled<L>(CountingArena<int>(arena, c), 1000);
+        CHECK(list.size() == 1000);
+        
+        /* Neither clear() nor the destructor visits a node */
+        list.clear();
+        CHECK(list.size() == 0);
+        CHECK(list.begin() == list.end());
+        CHECK(c.destroyed == 0);
+        CHECK(c.deallocated == 0);
+        
+        /* The cleared list is usable, new nodes come from the arena */
+        list.push_back(7);
+        CHECK(list.size() == 1);
+        CHECK(list.first() == 7);
+        
+        /* Removing single items still goes through the allocator */
+        L other = filled<L>(CountingArena<int>(arena, c), 500);
+        other.pop_front();
+        popped = c;
+    }
+    
+    /* Destroying both lists added nothing to that */
+    CHECK(c.destroyed == popped.destroyed);
+    CHECK(c.deallocated == popped.deallocated);
+    
+}
+
+template<typename L>
+void nonTrivialClearTest() {
+    
+    std::pmr::monotonic_buffer_resource arena;
+    ArenaCounters c;
+    Tracked::destructed = 0;
+    {
+        L list = filled<L>(CountingArena<Tracked>(arena, c), 100);
+        const size_t before = Tracked::destructed;
+        
+        /* Every item's destructor still runs, for clear() and ~List() */
+        list.clear();
+        CHECK(Tracked::destructed == before + 100);
+        CHECK(c.destroyed > 0);
+        
+        for (int i = 0; i < 50; ++i) {
+            list.push_back(Tracked(i));
+        }
+        Tracked::destructed = 0;
+    }
+    CHECK(Tracked::destructed == 50);
+    
+}
+
+void arenaListTest() {
+    
+    /* The plain ArenaList, with strings whose destructors free memory, */
+    /* so a skipped destructor shows up as a leak under AddressSanitizer */
+    std::pmr::monotonic_buffer_resource arena;
+    {
+        ArenaList<std::string> list{ArenaAllocator<std::string>(arena)};
+        for (int i = 0; i < 100; ++i) {
+            list.push_back(std::string(64, char('a' + i % 26)));
+        }
+        list.clear();
+        list.push_back(std::string(64, 'z'));
+        CHECK(list.first() == std::string(64, 'z'));
+    }
+    
+    ArenaList<int> numbers{ArenaAllocator<int>(arena)};
+    for (int i = 0; i < 100; ++i) {
+        numbers.push_back(i);
+    }
+    ArenaList<int> copy(numbers);
+    CHECK(copy.get_allocator() == numbers.get_allocator());
+    CHECK(copy.fold([](int & acc, const int i) { acc += i; }, 0) == 4950);
+    numbers.clear();
+    CHECK(numbers.size() == 0);
+    CHECK(copy.size() == 100);
+    
+}
+
+void bufferTest() {
+    
+    /* Lists built and cleared in rounds over a stack buffer never reach */
+    /* the upstream resource until the buffer runs out                  */
+    std::byte buffer[1024];
+    CountingResource upstream;
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), &upstream);
+    
+    for (int round = 0; round < 3; ++round) {
+        ArenaList<int> list(arena);
+        for (int i = 0; i < 5; ++i) {
+            list.push_back(round * 10 + i);
+        }
+        CHECK(list.fold([](int & acc, const int i) { acc += i; }, 0) == round * 50 + 10);
+        list.clear();
+        CHECK(list.size() == 0);
+    }
+    CHECK(upstream.allocations == 0);
+    
+    /* Cleared nodes are not reused, so enough rounds spill upstream */
+    for (int round = 0; round < 100; ++round) {
+        ArenaList<int> list(arena);
+        for (int i = 0; i < 5; ++i) {
+            list.push_back(i);
+        }
+    }
+    CHECK(upstream.allocations > 0);
+    arena.release();
+    
+}
+
+int main() {
+    
+    trivialClearTest<List<int, CountingArena<int>>>();
+    trivialClearTest<DList<int, CountingArena<int>>>();
+    trivialClearTest<UnrolledList<int, 8, CountingArena<int>>>();
+    nonTrivialClearTest<List<Tracked, CountingArena<Tracked>>>();
+    nonTrivialClearTest<DList<Tracked, CountingArena<Tracked>>>();
+    nonTrivialClearTest<UnrolledList<Tracked, 8, CountingArena<Tracked>>>();
+    arenaListTest();
+    bufferTest();
+    std::cout << "arena_allocator_test passed" << std::endl;
+    
+}
@@ -0,0 +1,35 @@
+//
+//  check.hpp
+//  linked_list
+//
+//  Assertion macros shared by the tests. A failed check prints where it
+//  failed and exits with status 1, which ctest reports as a failure.
+//
+
+#ifndef check_hpp
+#define check_hpp
+
+#include <iostream>
+#include <cstdlib>
+
+#define CHECK(cond)                                                     \
+    do {                                                                \
+        if (not (cond)) {                                               \
+            std::cerr << __FILE__ << ":" << __LINE__                    \
+                      << ": check failed: " #cond << std::endl;         \
+            std::exit(1);                                               \
+        }                                                               \
+    } while (false)
+
+#define CHECK_THROWS(expr, exception)                                   \
+    do {                                                                \
+        bool thrown = false;                                            \
+        try {                                                           \
+            (void)(expr);                                               \
+        } catch (const exception &) {                                   \
+            thrown = true;                                              \
+        }                                                               \
+        CHECK(thrown);                                                  \
+    } while (false)
+
+#endif /* check_hpp */
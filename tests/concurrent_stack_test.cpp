@@ -0,0 +1,104 @@
+//
+//  concurrent_stack_test.cpp
+//  linked_list
+//
+//  Multi-threaded stress test for ConcurrentStack. Workers push and pop
+//  concurrently while another thread repeatedly takes everything with
+//  pop_all(), every pushed item must be seen exactly once.
+//
+//  Build: g++ -std=c++20 -O2 -pthread -I.. concurrent_stack_test.cpp -o concurrent_stack_test
+//
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <cstdlib>
+
+#include "list.hpp"
+#include "concurrent_stack.hpp"
+#include "check.hpp"
+
+/* Same order as List::push/pop_front */
+void sequentialTest() {
+    
+    ConcurrentStack<std::string> stack;
+    CHECK(stack.empty());
+    CHECK(not stack.pop());
+    
+    for (int i = 0; i < 10; ++i) {
+        stack.push(std::to_string(i));
+    }
+    CHECK(*stack.pop() == "9");
+    
+    List<std::string> all = stack.pop_all();
+    CHECK(stack.empty());
+    CHECK(all.size() == 9);
+    CHECK(all.first() == "8");
+    CHECK(all.last() == "0");
+    
+    stack.emplace(3, 'x');
+    CHECK(*stack.pop() == "xxx");
+    stack.push("left over");
+    
+}
+
+void stressTest(const size_t workers, const size_t perWorker) {
+    
+    ConcurrentStack<size_t> stack;
+    std::vector<std::atomic<unsigned char>> seen(workers * perWorker);
+    std::atomic<size_t> workersDone = 0;
+    
+    const auto take = [&seen](const size_t item) {
+        CHECK(item < seen.size());
+        CHECK(seen[item].fetch_add(1) == 0);
+    };
+    
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < workers; ++w) {
+        threads.emplace_back([&, w]() {
+            for (size_t i = 0; i < perWorker; ++i) {
+                stack.push(w * perWorker + i);
+                if (i % 2) {
+                    if (const auto item = stack.pop()) {
+                        take(*item);
+                    }
+                }
+            }
+            ++workersDone;
+        });
+    }
+    
+    threads.emplace_back([&]() {
+        while (workersDone.load() < workers) {
+            for (const size_t item : stack.pop_all()) {
+                take(item);
+            }
+        }
+    });
+    
+    for (std::thread & t : threads) {
+        t.join();
+    }
+    
+    for (const size_t item : stack.pop_all()) {
+        take(item);
+    }
+    CHECK(stack.empty());
+    for (const auto & count : seen) {
+        CHECK(count.load() == 1);
+    }
+    
+}
+
+int main() {
+    
+    sequentialTest();
+    for (const size_t workers : { 1, 2, 4, 8 }) {
+        stressTest(workers, 100000);
+    }
+    std::cout << "concurrent_stack_test passed" << std::endl;
+    
+}
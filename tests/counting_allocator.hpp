@@ -0,0 +1,66 @@
+//
+//  counting_allocator.hpp
+//  linked_list
+//
+//  Stateful allocator for the tests. It counts allocated and freed
+//  elements, so a test can check how many nodes or blocks an operation
+//  allocates and that nothing is left once a container is gone.
+//
+
+#ifndef counting_allocator_hpp
+#define counting_allocator_hpp
+
+#include <memory>
+#include <cstddef>
+#include <type_traits>
+
+struct Counters {
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    
+    size_t live() const {
+        return allocations - deallocations;
+    }
+};
+
+/* Stateful, two allocators are equal when they share their counters */
+
+template<typename T>
+class CountingAllocator {
+    
+    template<typename> friend class CountingAllocator;
+    
+    Counters * counters;
+    
+public:
+    
+    typedef T value_type;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+    
+    explicit CountingAllocator(Counters & c) : counters(&c) { }
+    
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U> & other)
+        : counters(other.counters) { }
+    
+    T * allocate(const size_t n) {
+        counters->allocations += n;
+        return std::allocator<T>().allocate(n);
+    }
+    
+    void deallocate(T * ptr, const size_t n) noexcept {
+        counters->deallocations += n;
+        std::allocator<T>().deallocate(ptr, n);
+    }
+    
+    template<typename U>
+    bool operator==(const CountingAllocator<U> & other) const {
+        return counters == other.counters;
+    }
+    
+};
+
+#endif /* counting_allocator_hpp */
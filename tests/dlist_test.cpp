@@ -0,0 +1,299 @@
+//
+//  dlist_test.cpp
+//  linked_list
+//
+//  Unit tests for DList. Every check walks the list forwards through the
+//  next links and backwards through the prev links, so a broken link on
+//  either side shows up right after the operation that broke it.
+//
+//  Build: cmake --build <build dir> --target dlist_test && ctest
+//
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <iostream>
+
+#include "dlist.hpp"
+#include "fixtures.hpp"
+
+using Counted = DList<int, CountingAllocator<int>>;
+
+/* checkList(), then the same walk backwards through the prev links */
+
+template<typename T, typename Alloc>
+void checkLinks(const DList<T, Alloc> & list, const std::vector<T> & expected) {
+    
+    checkList(list, expected);
+    CHECK(std::equal(list.rbegin(), list.rend(),
+                     expected.rbegin(), expected.rend()));
+    CHECK(static_cast<size_t>(std::distance(list.rbegin(), list.rend())) ==
+          expected.size());
+    if (not expected.empty()) {
+        CHECK(*std::prev(list.end()) == expected.back());
+    }
+    
+}
+
+using Throwings = DList<Throwing, CountingAllocator<Throwing>>;
+
+static_assert(std::is_nothrow_move_constructible_v<DList<std::string>>);
+static_assert(std::is_nothrow_move_assignable_v<DList<std::string>>);
+static_assert(std::is_nothrow_swappable_v<DList<std::string>>);
+static_assert(std::is_nothrow_move_constructible_v<Counted>);
+static_assert(std::bidirectional_iterator<DList<int>::iterator>);
+
+
+/********************************************************************/
+/*                                                                  */
+/*                              Tests                               */
+/*                                                                  */
+/********************************************************************/
+
+void reverseIterationTest() {
+    
+    DList<int> list;
+    for (const int i : range(0, 5)) {
+        list.push_back(i);
+    }
+    
+    std::vector<int> backwards(list.rbegin(), list.rend());
+    CHECK(backwards == std::vector<int>({ 4, 3, 2, 1, 0 }));
+    
+    /* Through the const overloads and by hand from end() */
+    const DList<int> & view = list;
+    CHECK(std::equal(view.crbegin(), view.crend(), backwards.begin()));
+    auto it = view.end();
+    for (const int expected : backwards) {
+        CHECK(*--it == expected);
+    }
+    CHECK(it == view.begin());
+    
+    /* Writes through a reverse iterator */
+    *list.rbegin() = 40;
+    CHECK(list.last() == 40);
+    
+    DList<int> empty;
+    CHECK(empty.rbegin() == empty.rend());
+    
+}
+
+void popBackTest() {
+    
+    Counters c;
+    {
+        Counted list = counted<Counted>(c, range(0, 5));
+        
+        /* Reaches the tail through the sentinel's prev link and frees */
+        /* exactly that node, nothing is walked or reallocated          */
+        CHECK(list.pop_back() == 4);
+        CHECK(c.allocations == 5);
+        CHECK(c.deallocations == 1);
+        checkLinks(list, range(0, 4));
+        
+        list.push_back(9);
+        checkLinks(list, { 0, 1, 2, 3, 9 });
+        
+        while (list.size() > 1) {
+            list.pop_back();
+        }
+        checkLinks(list, { 0 });
+        CHECK(list.pop_back() == 0);
+        checkLinks(list, { });
+        CHECK_THROWS(list.pop_back(), std::runtime_error);
+        
+        /* The emptied sentinel links new nodes correctly again */
+        list.push_back(1);
+        list.push(0);
+        checkLinks(list, { 0, 1 });
+    }
+    CHECK(c.live() == 0);
+    
+}
+
+void iteratorInsertTest() {
+    
+    DList<int> list;
+    
+    /* Into an empty list, begin() == end() */
+    auto it = list.insert(list.end(), 2);
+    CHECK(*it == 2);
+    checkLinks(list, { 2 });
+    
+    /* Head and tail */
+    it = list.insert(list.begin(), 0);
+    CHECK(it == list.begin());
+    checkLinks(list, { 0, 2 });
+    it = list.insert(list.end(), 4);
+    CHECK(std::next(it) == list.end());
+    checkLinks(list, { 0, 2, 4 });
+    
+    /* Middle, and emplace returns an iterator to the new item */
+    list.insert(std::next(list.begin()), 1);
+    it = list.emplace(std::prev(list.end()), 3);
+    CHECK(*it == 3);
+    CHECK(*std::prev(it) == 2);
+    CHECK(*std::next(it) == 4);
+    checkLinks(list, range(0, 5));
+    
+}
+
+void iteratorEraseTest() {
+    
+    Counters c;
+    {
+        Counted list = counted<Counted>(c, range(0, 6));
+        
+        /* Head returns the new first item, tail returns end() */
+        auto it = list.erase(list.begin());
+        CHECK(it == list.begin());
+        CHECK(*it == 1);
+        checkLinks(list, range(1, 6));
+        
+        it = list.erase(std::prev(list.end()));
+        CHECK(it == list.end());
+        checkLinks(list, range(1, 5));
+        
+        /* Middle, the neighbours now link to each other both ways */
+        it = list.erase(std::next(list.begin()));
+        CHECK(*it == 3);
+        CHECK(*std::prev(it) == 1);
+        checkLinks(list, { 1, 3, 4 });
+        CHECK(c.deallocations == 3);
+        
+        /* Ranges: empty, head to middle, everything */
+        CHECK(list.erase(list.begin(), list.begin()) == list.begin());
+        checkLinks(list, { 1, 3, 4 });
+        it = list.erase(list.begin(), std::prev(list.end()));
+        CHECK(it == list.begin());
+        checkLinks(list, { 4 });
+        CHECK(list.erase(list.begin(), list.end()) == list.end());
+        checkLinks(list, { });
+        CHECK(c.live() == 0);
+        
+        /* remove_if unlinks runs of adjacent nodes */
+        for (const int i : range(0, 10)) {
+            list.push_back(i);
+        }
+        CHECK(list.remove_if([](const int i) { return i < 2 or i == 4 or
+                                                      i == 5 or i > 7; }) == 6);
+        checkLinks(list, { 2, 3, 6, 7 });
+        CHECK(list.remove(1) == 3);
+        CHECK(list.remove(2) == 7);
+        checkLinks(list, { 2, 6 });
+        
+        /* Erasing while iterating, with the iterator erase() returns */
+        list.clear();
+        for (const int i : range(0, 10)) {
+            list.push_back(i);
+        }
+        for (auto it = list.begin(); it != list.end(); ) {
+            it = (*it % 3) ? std::next(it) : list.erase(it);
+        }
+        checkLinks(list, { 1, 2, 4, 5, 7, 8 });
+    }
+    CHECK(c.live() == 0);
+    
+}
+
+void throwingCopyTest() {
+    
+    Counters c;
+    {
+        Throwings from{CountingAllocator<Throwing>(c)};
+        for (const int i : range(0, 5)) {
+            from.push_back(Throwing(i));
+        }
+        
+        /* Copy constructor: the partial copy is freed */
+        Throwing::budget = 3;
+        CHECK_THROWS(Throwings(from), std::runtime_error);
+        CHECK(c.live() == 5);
+        
+        /* Append and copy assignment leave the target untouched */
+        Throwings to{CountingAllocator<Throwing>(c)};
+        to.push_back(Throwing(9));
+        Throwing::budget = 2;
+        CHECK_THROWS(to.append(from), std::runtime_error);
+        CHECK(c.live() == 6);
+        Throwing::budget = 4;
+        CHECK_THROWS(to = from, std::runtime_error);
+        CHECK(c.live() == 6);
+        CHECK(to.size() == 1);
+        CHECK(to.first() == Throwing(9));
+        CHECK(to.last() == Throwing(9));
+        
+        Throwing::budget = -1;
+        to = from;
+        CHECK(to.size() == 5);
+        CHECK(std::equal(to.rbegin(), to.rend(), from.rbegin(), from.rend()));
+        
+        /* Appending a list to itself copies it once */
+        to.append(to);
+        CHECK(to.size() == 10);
+        CHECK(to[5] == Throwing(0));
+        CHECK(to.last() == Throwing(4));
+    }
+    CHECK(c.live() == 0);
+    
+}
+
+void moveAndSwapTest() {
+    
+    Counters c;
+    Counters d;
+    {
+        Counted a = counted<Counted>(c, range(0, 3));
+        Counted b = counted<Counted>(d, range(3, 8));
+        Counted empty{CountingAllocator<int>(d)};
+        
+        /* POCS: the nodes go with their allocators */
+        a.swap(b);
+        checkLinks(a, range(3, 8));
+        checkLinks(b, range(0, 3));
+        CHECK(a.get_allocator() == CountingAllocator<int>(d));
+        
+        swap(a, empty);
+        checkLinks(a, { });
+        checkLinks(empty, range(3, 8));
+        a.swap(empty);
+        checkLinks(a, range(3, 8));
+        checkLinks(empty, { });
+        
+        a.swap(a);
+        checkLinks(a, range(3, 8));
+        
+        /* Move construction and assignment only relink the sentinels */
+        const size_t allocations = c.allocations + d.allocations;
+        Counted moved(std::move(a));
+        checkLinks(moved, range(3, 8));
+        checkLinks(a, { });
+        b = std::move(moved);
+        checkLinks(b, range(3, 8));
+        checkLinks(moved, { });
+        CHECK(c.allocations + d.allocations == allocations);
+        
+        /* A moved-from list is usable */
+        moved.push_back(1);
+        checkLinks(moved, { 1 });
+    }
+    CHECK(c.live() == 0);
+    CHECK(d.live() == 0);
+    
+}
+
+int main() {
+    
+    reverseIterationTest();
+    popBackTest();
+    iteratorInsertTest();
+    iteratorEraseTest();
+    throwingCopyTest();
+    moveAndSwapTest();
+    std::cout << "dlist_test passed" << std::endl;
+    
+}
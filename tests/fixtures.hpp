@@ -0,0 +1,110 @@
+//
+//  fixtures.hpp
+//  linked_list
+//
+//  Fixtures shared by the container tests: checkList() compares a
+//  container with the expected items through every accessor, range() and
+//  counted<L>() build inputs, and Throwing fails on a chosen copy to
+//  exercise the exception guarantees.
+//
+
+#ifndef fixtures_hpp
+#define fixtures_hpp
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include <cstddef>
+
+#include "check.hpp"
+#include "counting_allocator.hpp"
+
+/* Checks contents, size, first/last and indexed access in both */
+/* directions. Allocates nothing, so counters can be checked around it */
+
+template<typename L>
+void checkList(const L & list, const std::vector<typename L::value_type> & expected) {
+    
+    CHECK(list.size() == expected.size());
+    CHECK(std::equal(list.begin(), list.end(),
+                     expected.begin(), expected.end()));
+    CHECK(std::equal(list.cbegin(), list.cend(),
+                     expected.begin(), expected.end()));
+    CHECK(static_cast<size_t>(std::distance(list.begin(), list.end())) ==
+          expected.size());
+    
+    if (expected.empty()) {
+        CHECK(list.begin() == list.end());
+        CHECK_THROWS(list.first(), std::out_of_range);
+        CHECK_THROWS(list.last(), std::out_of_range);
+    } else {
+        CHECK(list.first() == expected.front());
+        CHECK(list.last() == expected.back());
+    }
+    
+    for (size_t i = 0; i < expected.size(); ++i) {
+        CHECK(list[i] == expected[i]);
+    }
+    for (size_t i = expected.size(); i-- > 0; ) {
+        CHECK(list.at(i) == expected[i]);
+    }
+    CHECK_THROWS(list.at(expected.size()), std::out_of_range);
+    
+}
+
+/* from, from + 1, ..., to - 1 */
+
+inline std::vector<int> range(const int from, const int to) {
+    std::vector<int> items;
+    for (int i = from; i < to; ++i) {
+        items.push_back(i);
+    }
+    return items;
+}
+
+/* A container of items whose allocator counts into c */
+
+template<typename L>
+L counted(Counters & c, const std::vector<typename L::value_type> & items) {
+    L list{CountingAllocator<typename L::value_type>(c)};
+    for (const auto & item : items) {
+        list.push_back(item);
+    }
+    return list;
+}
+
+/* Throws on the copy that brings budget to zero, moves never throw */
+
+struct Throwing {
+    
+    inline static int budget = -1;
+    int value = 0;
+    
+    Throwing() = default;
+    Throwing(const int v) : value(v) { }
+    
+    Throwing(const Throwing & other) : value(other.value) {
+        if (budget-- == 0) {
+            throw std::runtime_error("copy");
+        }
+    }
+    
+    Throwing & operator=(const Throwing & other) {
+        if (budget-- == 0) {
+            throw std::runtime_error("copy");
+        }
+        value = other.value;
+        return *this;
+    }
+    
+    Throwing(Throwing &&) noexcept = default;
+    Throwing & operator=(Throwing &&) noexcept = default;
+    
+    bool operator==(const Throwing & other) const {
+        return value == other.value;
+    }
+    
+};
+
+#endif /* fixtures_hpp */
@@ -0,0 +1,248 @@
+//
+//  intrusive_list_test.cpp
+//  linked_list
+//
+//  Unit tests for IntrusiveList. Elements live in a plain array, so any
+//  stray access outside of it shows up under the sanitizers.
+//
+//  Build: g++ -std=c++20 -I.. intrusive_list_test.cpp -o intrusive_list_test
+//
+
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include <cstdlib>
+#include <stdexcept>
+#include <algorithm>
+
+#include "intrusive_list.hpp"
+#include "check.hpp"
+
+/* Two hooks, so a task can be in a run queue and a timer list at once */
+
+struct Task {
+    
+    int id = 0;
+    IntrusiveHook<Task> runHook;
+    IntrusiveHook<Task> timerHook;
+    
+};
+
+typedef IntrusiveList<Task, &Task::runHook> RunQueue;
+typedef IntrusiveList<Task, &Task::timerHook> TimerList;
+
+static_assert(std::forward_iterator<RunQueue::iterator>);
+static_assert(std::forward_iterator<RunQueue::const_iterator>);
+
+template<typename L>
+std::vector<int> ids(const L & list) {
+    
+    std::vector<int> result;
+    for (const Task & task : list) {
+        result.push_back(task.id);
+    }
+    
+    /* back() must agree with the forward chain */
+    CHECK(result.size() == list.size());
+    if (not result.empty()) {
+        CHECK(list.last().id == result.back());
+    }
+    return result;
+    
+}
+
+struct Pool {
+    
+    Task tasks[8];
+    
+    Pool() {
+        for (int i = 0; i < 8; ++i) {
+            tasks[i].id = i;
+        }
+    }
+    
+};
+
+void pushPopTest() {
+    
+    Pool pool;
+    RunQueue queue;
+    
+    CHECK(queue.empty());
+    CHECK_THROWS(queue.pop_front(), std::runtime_error);
+    CHECK_THROWS(queue.pop_back(), std::runtime_error);
+    CHECK_THROWS(queue.first(), std::out_of_range);
+    
+    queue.push_back(pool.tasks[1]).push_back(pool.tasks[2]).push(pool.tasks[0]);
+    CHECK(ids(queue) == std::vector<int>({ 0, 1, 2 }));
+    CHECK(&queue.first() == &pool.tasks[0]);
+    CHECK(&queue[2] == &pool.tasks[2]);
+    CHECK_THROWS(queue.at(3), std::out_of_range);
+    
+    CHECK(&queue.pop_front() == &pool.tasks[0]);
+    CHECK(&queue.pop_back() == &pool.tasks[2]);
+    CHECK(ids(queue) == std::vector<int>({ 1 }));
+    CHECK(&queue.pop_front() == &pool.tasks[1]);
+    CHECK(queue.empty());
+    
+    /* Popped elements can be linked again */
+    queue.push(pool.tasks[0]).push(pool.tasks[1]);
+    CHECK(ids(queue) == std::vector<int>({ 1, 0 }));
+    
+}
+
+void insertRemoveTest() {
+    
+    Pool pool;
+    RunQueue queue;
+    
+    /* Indices as in List::insert: the last index appends and size() */
+    /* is out of range, so nothing can be inserted into an empty list */
+    CHECK_THROWS(queue.insert(0, pool.tasks[0]), std::out_of_range);
+    queue.push_back(pool.tasks[2]).push(pool.tasks[0]);
+    queue.insert(1, pool.tasks[3]);
+    CHECK(ids(queue) == std::vector<int>({ 0, 2, 3 }));
+    queue.insert(1, pool.tasks[1]);
+    CHECK_THROWS(queue.insert(4, pool.tasks[4]), std::out_of_range);
+    CHECK(ids(queue) == std::vector<int>({ 0, 1, 2, 3 }));
+    
+    CHECK(&queue.remove(2) == &pool.tasks[2]);
+    CHECK_THROWS(queue.remove(3), std::out_of_range);
+    CHECK(ids(queue) == std::vector<int>({ 0, 1, 3 }));
+    
+    auto it = queue.insert(queue.iterator_to(pool.tasks[3]), pool.tasks[2]);
+    CHECK(&*it == &pool.tasks[2]);
+    queue.insert(queue.end(), pool.tasks[4]);
+    CHECK(ids(queue) == std::vector<int>({ 0, 1, 2, 3, 4 }));
+    
+    it = queue.erase(queue.iterator_to(pool.tasks[3]));
+    CHECK(&*it == &pool.tasks[4]);
+    CHECK(queue.erase(it) == queue.end());
+    CHECK(ids(queue) == std::vector<int>({ 0, 1, 2 }));
+    
+}
+
+void unlinkTest() {
+    
+    Pool pool;
+    RunQueue queue;
+    for (Task & task : pool.tasks) {
+        queue.push_back(task);
+    }
+    
+    /* Middle, front, back, then the only element */
+    queue.unlink(pool.tasks[4]);
+    queue.unlink(pool.tasks[0]);
+    queue.unlink(pool.tasks[7]);
+    CHECK(ids(queue) == std::vector<int>({ 1, 2, 3, 5, 6 }));
+    CHECK(&queue.first() == &pool.tasks[1]);
+    
+    CHECK(queue.remove_if([](const Task & t) { return t.id != 3; }) == 4);
+    CHECK(ids(queue) == std::vector<int>({ 3 }));
+    queue.unlink(pool.tasks[3]);
+    CHECK(queue.empty());
+    CHECK_THROWS(queue.last(), std::out_of_range);
+    
+    queue.push_back(pool.tasks[4]);
+    CHECK(ids(queue) == std::vector<int>({ 4 }));
+    
+}
+
+void twoHookTest() {
+    
+    Pool pool;
+    RunQueue queue;
+    TimerList timers;
+    
+    for (Task & task : pool.tasks) {
+        queue.push_back(task);
+        timers.push(task);
+    }
+    
+    queue.unlink(pool.tasks[5]);
+    timers.unlink(pool.tasks[2]);
+    
+    CHECK(ids(queue) == std::vector<int>({ 0, 1, 2, 3, 4, 6, 7 }));
+    CHECK(ids(timers) == std::vector<int>({ 7, 6, 5, 4, 3, 1, 0 }));
+    
+}
+
+void appendMoveTest() {
+    
+    Pool pool;
+    RunQueue a;
+    RunQueue b;
+    
+    a.push_back(pool.tasks[0]).push_back(pool.tasks[1]);
+    b.push_back(pool.tasks[2]).push_back(pool.tasks[3]);
+    
+    a += std::move(b);
+    CHECK(b.empty());
+    CHECK(ids(a) == std::vector<int>({ 0, 1, 2, 3 }));
+    
+    b.append(std::move(a));
+    CHECK(a.empty());
+    CHECK(ids(b) == std::vector<int>({ 0, 1, 2, 3 }));
+    
+    RunQueue c(std::move(b));
+    CHECK(b.empty());
+    CHECK(ids(c) == std::vector<int>({ 0, 1, 2, 3 }));
+    
+    /* Move assignment unlinks what the target held */
+    RunQueue d;
+    d.push_back(pool.tasks[4]);
+    d = std::move(c);
+    CHECK(ids(d) == std::vector<int>({ 0, 1, 2, 3 }));
+    c.push_back(pool.tasks[4]);
+    CHECK(ids(c) == std::vector<int>({ 4 }));
+    
+    /* Destruction and clear() unlink too */
+    {
+        RunQueue e;
+        e.push_back(pool.tasks[5]);
+    }
+    d.clear();
+    CHECK(d.empty());
+    d.push_back(pool.tasks[5]).push_back(pool.tasks[0]);
+    CHECK(ids(d) == std::vector<int>({ 5, 0 }));
+    
+}
+
+void algorithmTest() {
+    
+    Pool pool;
+    RunQueue queue;
+    for (Task & task : pool.tasks) {
+        queue.push_back(task);
+    }
+    
+    const auto found = std::find_if(queue.cbegin(), queue.cend(),
+                                    [](const Task & t) { return t.id == 6; });
+    CHECK(&*found == &pool.tasks[6]);
+    CHECK(std::distance(queue.begin(), queue.end()) == 8);
+    
+    for (Task & task : queue) {
+        task.id *= 10;
+    }
+    CHECK(pool.tasks[7].id == 70);
+    
+    /* Copying an element does not copy its membership */
+    Task copy = pool.tasks[3];
+    RunQueue other;
+    other.push_back(copy);
+    CHECK(ids(other) == std::vector<int>({ 30 }));
+    CHECK(queue.size() == 8);
+    
+}
+
+int main() {
+    
+    pushPopTest();
+    insertRemoveTest();
+    unlinkTest();
+    twoHookTest();
+    appendMoveTest();
+    algorithmTest();
+    std::cout << "intrusive_list_test passed" << std::endl;
+    
+}
@@ -0,0 +1,290 @@
+//
+//  list_io_test.cpp
+//  linked_list
+//
+//  Tests for the binary format in list_io.hpp: round trips through a
+//  stream, rejected and truncated files, the single allocation bulk load
+//  into an ArenaList and MappedList over a temporary file.
+//
+//  Build: cmake --build <build dir> --target list_io_test && ctest
+//
+
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+
+#include "list.hpp"
+#include "list_io.hpp"
+#include "list_views.hpp"
+#include "arena_allocator.hpp"
+#include "check.hpp"
+
+struct Point {
+    
+    int x;
+    int y;
+    
+    Point(const int x, const int y) : x(x), y(y) { }
+    
+    bool operator==(const Point &) const = default;
+    
+};
+
+static_assert(binary_serializable<Point>);
+static_assert(not binary_serializable<std::string>);
+
+/* Counts what the arena asks its upstream for */
+class CountingResource : public std::pmr::memory_resource {
+    
+    void * do_allocate(const size_t bytes, const size_t align) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    
+    void do_deallocate(void * ptr, const size_t bytes, const size_t align) override {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, align);
+    }
+    
+    bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override {
+        return this == &other;
+    }
+    
+public:
+    
+    size_t allocations = 0;
+    
+};
+
+/* Hands out its bytes without supporting seeks, like a pipe */
+class PipeBuffer : public std::streambuf {
+    
+    std::string bytes;
+    
+public:
+    
+    explicit PipeBuffer(std::string contents) : bytes(std::move(contents)) {
+        setg(bytes.data(), bytes.data(), bytes.data() + bytes.size());
+    }
+    
+};
+
+List<int> numbers(const int count) {
+    
+    List<int> list;
+    for (int i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+    return list;
+    
+}
+
+template<typename L>
+std::vector<typename L::value_type> items(const L & list) {
+    return std::vector<typename L::value_type>(list.begin(), list.end());
+}
+
+std::string serialize(const List<int> & list) {
+    
+    std::ostringstream out;
+    write_binary(list, out);
+    return out.str();
+    
+}
+
+void roundTripTest() {
+    
+    /* Spans several read and write blocks */
+    const List<int> list = numbers(50000);
+    const std::string bytes = serialize(list);
+    CHECK(bytes.size() == sizeof(ListFileHeader) + 50000 * sizeof(int));
+    
+    std::istringstream in(bytes);
+    const List<int> loaded = read_binary<int>(in);
+    CHECK(loaded.size() == 50000);
+    CHECK(items(loaded) == items(list));
+    CHECK(loaded.last() == 49999);
+    
+    /* Items without a default constructor */
+    List<Point> points;
+    points.push_back(Point(1, 2)).push_back(Point(3, 4));
+    std::stringstream stream;
+    write_binary(points, stream);
+    List<Point> copy = read_binary<Point>(stream);
+    CHECK(items(copy) == items(points));
+    copy.push_back(Point(5, 6));
+    CHECK(copy.size() == 3);
+    
+    /* Empty lists */
+    std::istringstream empty(serialize(List<int>()));
+    List<int> none = read_binary<int>(empty);
+    CHECK(none.size() == 0);
+    none.push_back(1);
+    CHECK(none.first() == 1);
+    
+}
+
+void rejectTest() {
+    
+    const std::string bytes = serialize(numbers(100));
+    
+    /* Another item type */
+    std::istringstream asDouble(bytes);
+    CHECK_THROWS(read_binary<double>(asDouble), std::runtime_error);
+    
+    /* Not a list file at all */
+    std::istringstream garbage(std::string(64, 'x'));
+    CHECK_THROWS(read_binary<int>(garbage), std::runtime_error);
+    
+    /* Cut in the header and in the items */
+    std::istringstream shortHeader(bytes.substr(0, 10));
+    CHECK_THROWS(read_binary<int>(shortHeader), std::runtime_error);
+    std::istringstream shortItems(bytes.substr(0, bytes.size() - 1));
+    CHECK_THROWS(read_binary<int>(shortItems), std::runtime_error);
+    
+    std::pmr::monotonic_buffer_resource arena;
+    std::istringstream shortArena(bytes.substr(0, bytes.size() - 1));
+    CHECK_THROWS(read_binary<int>(shortArena, ArenaAllocator<int>(arena)),
+                 std::runtime_error);
+    
+    PipeBuffer pipe(bytes.substr(0, bytes.size() - 1));
+    std::istream shortPipe(&pipe);
+    CHECK_THROWS(read_binary<int>(shortPipe, ArenaAllocator<int>(arena)),
+                 std::runtime_error);
+    
+}
+
+/* Headers whose count is far beyond the items that follow */
+void forgedCountTest() {
+    
+    const std::string bytes = serialize(numbers(16384));
+    
+    for (const uint64_t count : { uint64_t(1) << 60, uint64_t(16385),
+                                  std::numeric_limits<uint64_t>::max() }) {
+        
+        std::string forged = bytes;
+        std::memcpy(forged.data() + offsetof(ListFileHeader, count), &count, sizeof(count));
+        
+        std::istringstream plain(forged);
+        CHECK_THROWS(read_binary<int>(plain), std::runtime_error);
+        
+        CountingResource upstream;
+        std::pmr::monotonic_buffer_resource arena(&upstream);
+        std::istringstream bulk(forged);
+        CHECK_THROWS(read_binary<int>(bulk, ArenaAllocator<int>(arena)),
+                     std::runtime_error);
+        CHECK(upstream.allocations == 0);
+        
+        /* Without a length to check against, nodes are only allocated */
+        /* for items actually read                                     */
+        PipeBuffer pipe(forged);
+        std::istream unsized(&pipe);
+        CHECK_THROWS(read_binary<int>(unsized, ArenaAllocator<int>(arena)),
+                     std::runtime_error);
+        
+    }
+    
+    /* The arena itself refuses sizes that overflow */
+    std::pmr::monotonic_buffer_resource arena;
+    ArenaAllocator<int> allocator(arena);
+    CHECK_THROWS(allocator.allocate(allocator.max_size() + 1), std::bad_array_new_length);
+    CHECK_THROWS(allocator.allocate(size_t(1) << 62), std::bad_array_new_length);
+    
+}
+
+void bulkLoadTest() {
+    
+    const std::string bytes = serialize(numbers(100000));
+    
+    CountingResource upstream;
+    std::pmr::monotonic_buffer_resource arena(&upstream);
+    
+    std::istringstream in(bytes);
+    ArenaList<int> list = read_binary<int>(in, ArenaAllocator<int>(arena));
+    CHECK(upstream.allocations == 1);
+    CHECK(list.size() == 100000);
+    CHECK(list.fold([](long & acc, const int i) { acc += i; }, 0L) == 4999950000L);
+    
+    /* The loaded nodes behave like any others */
+    list.pop_front();
+    list.remove(1000);
+    list.push_back(-1);
+    list.insert(5, -2);
+    CHECK(list.size() == 100000);
+    CHECK(list.first() == 1);
+    CHECK(list.last() == -1);
+    CHECK(list[5] == -2);
+    list.sort();
+    CHECK(list.first() == -2);
+    CHECK(list.last() == 99999);
+    
+}
+
+#ifdef LIST_IO_HAS_MMAP
+
+void mappedTest() {
+    
+    const std::filesystem::path path = std::filesystem::temp_directory_path() /
+        ("list_io_test_" + std::to_string(getpid()) + ".bin");
+    
+    {
+        std::ofstream out(path, std::ios::binary);
+        write_binary(numbers(1000), out);
+    }
+    
+    {
+        MappedList<int> mapped(path.string());
+        CHECK(mapped.size() == 1000);
+        CHECK(mapped[0] == 0);
+        CHECK(mapped.at(999) == 999);
+        CHECK_THROWS(mapped.at(1000), std::out_of_range);
+        CHECK(std::accumulate(mapped.begin(), mapped.end(), 0) == 499500);
+        
+        /* Works as a source for the view pipelines */
+        const List<int> odd = mapped | std::views::filter([](const int i) { return i % 2; })
+                                     | to_list();
+        CHECK(odd.size() == 500);
+        CHECK(odd.last() == 999);
+        
+        MappedList<int> moved(std::move(mapped));
+        CHECK(moved.size() == 1000);
+        CHECK(mapped.size() == 0);
+        CHECK(mapped.begin() == mapped.end());
+    }
+    
+    CHECK_THROWS(MappedList<double>(path.string()), std::runtime_error);
+    
+    /* Items missing from the end */
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    CHECK_THROWS(MappedList<int>(path.string()), std::runtime_error);
+    
+    std::filesystem::remove(path);
+    CHECK_THROWS(MappedList<int>(path.string()), std::system_error);
+    
+}
+
+#endif /* LIST_IO_HAS_MMAP */
+
+int main() {
+    
+    roundTripTest();
+    rejectTest();
+    forgedCountTest();
+    bulkLoadTest();
+#ifdef LIST_IO_HAS_MMAP
+    mappedTest();
+#endif
+    std::cout << "list_io_test passed" << std::endl;
+    
+}
@@ -0,0 +1,126 @@
+//
+//  list_stats_test.cpp
+//  linked_list
+//
+//  Checks the LINKED_LIST_INSTRUMENTATION counters against operations
+//  with a known cost.
+//
+//  Build: cmake --build <build dir> --target list_stats_test && ctest
+//
+
+#ifndef LINKED_LIST_INSTRUMENTATION
+#define LINKED_LIST_INSTRUMENTATION
+#endif
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+
+#include "list.hpp"
+#include "check.hpp"
+
+uint64_t calls(const ListCounters & counters, const ListOp op) {
+    return counters.calls[size_t(op)];
+}
+
+void allocationTest() {
+    
+    list_stats.reset();
+    {
+        List<int> list;
+        for (int i = 0; i < 100; ++i) {
+            list.push_back(i);
+        }
+        List<int> copy(list);
+        copy.pop_front();
+    }
+    
+    const ListCounters counters = list_stats.snapshot();
+    CHECK(counters.nodesAllocated == 200);
+    CHECK(counters.nodesFreed == 200);
+    CHECK(counters.peakLength == 100);
+    CHECK(calls(counters, ListOp::push_back) == 100);
+    CHECK(calls(counters, ListOp::copy) == 1);
+    CHECK(calls(counters, ListOp::pop_front) == 1);
+    
+}
+
+void walkTest() {
+    
+    List<int> list;
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    list_stats.reset();
+    
+    /* Ascending indexing resumes from the cursor, one hop per step */
+    for (size_t i = 0; i < list.size(); ++i) {
+        (void)list[i];
+    }
+    ListCounters counters = list_stats.snapshot();
+    CHECK(calls(counters, ListOp::at) == 10);
+    CHECK(counters.nodeAtCalls == 10);
+    CHECK(counters.nodeAtHops == 8);
+    
+    /* Every pop_back looks up the second to last node, the first one */
+    /* finds it at the cursor left by the loop, the second walks      */
+    const ListCounters before = list_stats.snapshot();
+    list.pop_back();
+    list.pop_back();
+    counters = list_stats.snapshot() - before;
+    CHECK(calls(counters, ListOp::pop_back) == 2);
+    CHECK(counters.popBackScans == 2);
+    CHECK(counters.nodeAtHops == 0 + 7);
+    
+}
+
+void orderingTest() {
+    
+    List<int> list;
+    for (const int i : { 1, 1, 2, 3, 3, 3 }) {
+        list.push_back(i);
+    }
+    list_stats.reset();
+    
+    CHECK(list.unique() == 3);
+    list.reverse();
+    list.sort();
+    
+    const ListCounters counters = list_stats.snapshot();
+    CHECK(calls(counters, ListOp::unique) == 1);
+    CHECK(calls(counters, ListOp::reverse) == 1);
+    CHECK(calls(counters, ListOp::sort) == 1);
+    CHECK(counters.nodesFreed == 3);
+    
+}
+
+void dumpTest() {
+    
+    std::ostringstream out;
+    {
+        ListStatsScope scope("scope", out);
+        List<std::string> list;
+        list.push("a");
+        list.sort();
+        list.reverse();
+    }
+    
+    const std::string dump = out.str();
+    CHECK(dump.find("scope:") == 0);
+    CHECK(dump.find("nodes allocated") != std::string::npos);
+    CHECK(dump.find("sort") != std::string::npos);
+    CHECK(dump.find("reverse") != std::string::npos);
+    CHECK(dump.find("remove_if") == std::string::npos);
+    
+}
+
+int main() {
+    
+    allocationTest();
+    walkTest();
+    orderingTest();
+    dumpTest();
+    std::cout << "list_stats_test passed" << std::endl;
+    
+}
@@ -0,0 +1,467 @@
+//
+//  list_test.cpp
+//  linked_list
+//
+//  Unit tests for List<T, Alloc>. Every public method is checked against
+//  the expected contents, size(), first()/last() and indexed access, and
+//  a counting allocator checks how many nodes each operation allocates.
+//
+//  Build: cmake --build <build dir> --target list_test && ctest
+//
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cstdlib>
+
+#include "list.hpp"
+#include "fixtures.hpp"
+
+
+typedef List<int, CountingAllocator<int>> CountedList;
+typedef List<std::string, CountingAllocator<std::string>> CountedStrings;
+
+
+/********************************************************************/
+/*                                                                  */
+/*                             Helpers                              */
+/*                                                                  */
+/********************************************************************/
+
+template<typename T, typename Alloc>
+std::vector<T> contents(const List<T, Alloc> & list) {
+    return std::vector<T>(list.begin(), list.end());
+}
+
+
+
+/********************************************************************/
+/*                                                                  */
+/*                              Tests                               */
+/*                                                                  */
+/********************************************************************/
+
+void constructionTest() {
+    
+    Counters c;
+    {
+        CountedList empty{CountingAllocator<int>(c)};
+        checkList(empty, {});
+        CHECK(empty.get_allocator() == CountingAllocator<int>(c));
+        
+        CountedList list = counted<CountedList>(c, { 1, 2, 3 });
+        CHECK(c.live() == 3);
+        
+        CountedList copy(list);
+        CHECK(c.live() == 6);
+        checkList(copy, { 1, 2, 3 });
+        
+        const size_t before = c.allocations;
+        CountedList moved(std::move(list));
+        CHECK(c.allocations == before);
+        checkList(moved, { 1, 2, 3 });
+        checkList(list, {});
+    }
+    CHECK(c.live() == 0);
+    
+    static_assert(std::is_nothrow_move_constructible_v<List<std::string>>);
+    static_assert(std::is_nothrow_move_assignable_v<List<std::string>>);
+    static_assert(std::forward_iterator<List<int>::iterator>);
+    static_assert(std::forward_iterator<List<int>::const_iterator>);
+    
+}
+
+void accessTest() {
+    
+    List<int> list;
+    for (int i = 0; i < 10; ++i) {
+        list.push_back(i);
+    }
+    
+    list[3] = 30;
+    list.at(4) = 40;
+    list.first() = -1;
+    list.last() = 90;
+    checkList(list, { -1, 1, 2, 30, 40, 5, 6, 7, 8, 90 });
+    
+    /* Indexing in every order, the node_at() cursor must not go stale */
+    CHECK(list[7] == 7);
+    CHECK(list[2] == 2);
+    CHECK(list[8] == 8);
+    list.remove(8);
+    CHECK(list[8] == 90);
+    list.push(-2);
+    CHECK(list[8] == 7);
+    CHECK(list[0] == -2);
+    
+    CHECK_THROWS(list.at(100), std::out_of_range);
+    CHECK_THROWS(list[10], std::out_of_range);
+    
+}
+
+void iteratorTest() {
+    
+    List<int> list;
+    for (int i = 0; i < 5; ++i) {
+        list.push_back(i);
+    }
+    
+    for (int & i : list) {
+        i *= 2;
+    }
+    checkList(list, { 0, 2, 4, 6, 8 });
+    
+    List<int>::const_iterator it = list.begin();
+    CHECK(*it == 0);
+    CHECK(*it++ == 0);
+    CHECK(*++it == 4);
+    CHECK(it != list.cend());
+    CHECK(std::next(list.before_begin()) == list.begin());
+    CHECK(std::next(list.cbefore_begin()) == list.cbegin());
+    CHECK(std::find(list.begin(), list.end(), 6) != list.end());
+    
+    const List<int> & constList = list;
+    CHECK(std::accumulate(constList.begin(), constList.end(), 0) == 20);
+    
+}
+
+void insertionTest() {
+    
+    Counters c;
+    CountedList list{CountingAllocator<int>(c)};
+    
+    const int one = 1;
+    list.push_back(one).push_back(2).push_back(short(3));
+    CHECK(list.emplace_back(4) == 4);
+    checkList(list, { 1, 2, 3, 4 });
+    
+    list.push(one).push(0).push(short(-1));
+    CHECK(list.emplace_front(-2) == -2);
+    checkList(list, { -2, -1, 0, 1, 1, 2, 3, 4 });
+    
+    /* The last index appends, like push_back */
+    list.insert(7, one);
+    list.insert(0, 10);
+    list.insert(2, short(20));
+    CHECK(list.emplace(3, 30) == 30);
+    checkList(list, { 10, -2, 20, 30, -1, 0, 1, 1, 2, 3, 4, 1 });
+    CHECK_THROWS(list.insert(100, 1), std::out_of_range);
+    
+    CHECK(c.live() == list.size());
+    
+    List<std::string> strings;
+    strings.push_back(3, 'a');
+    strings.push(std::string("b"));
+    strings.insert(1, "c");
+    CHECK(strings.emplace_back(2, 'd') == "dd");
+    checkList(strings, { "b", "aaa", "c", "dd" });
+    
+}
+
+void removalTest() {
+    
+    Counters c;
+    CountedList list = counted<CountedList>(c, { 0, 1, 2, 3, 4, 5 });
+    
+    CHECK(list.pop_front() == 0);
+    CHECK(list.pop_back() == 5);
+    CHECK(list.remove(1) == 2);
+    CHECK(list.remove(2) == 4);
+    checkList(list, { 1, 3 });
+    CHECK(c.live() == 2);
+    
+    CHECK(list.pop_back() == 3);
+    CHECK(list.pop_front() == 1);
+    checkList(list, {});
+    CHECK(c.live() == 0);
+    
+    CHECK_THROWS(list.pop_front(), std::runtime_error);
+    CHECK_THROWS(list.pop_back(), std::runtime_error);
+    CHECK_THROWS(list.remove(0), std::out_of_range);
+    
+    list.push_back(7);
+    checkList(list, { 7 });
+    
+}
+
+void afterIteratorTest() {
+    
+    Counters c;
+    CountedList list{CountingAllocator<int>(c)};
+    
+    auto it = list.insert_after(list.before_begin(), 1);
+    const int two = 2;
+    it = list.insert_after(it, two);
+    CHECK(*list.emplace_after(it, 3) == 3);
+    list.insert_after(list.before_begin(), 0);
+    checkList(list, { 0, 1, 2, 3 });
+    
+    CHECK(*list.erase_after(list.begin()) == 2);
+    checkList(list, { 0, 2, 3 });
+    CHECK(list.erase_after(std::next(list.begin())) == list.end());
+    checkList(list, { 0, 2 });
+    
+    list.push_back(5);
+    list.push_back(6);
+    const auto next = list.erase_after(list.before_begin(),
+                                       std::next(list.begin(), 2));
+    CHECK(next == list.begin());
+    checkList(list, { 5, 6 });
+    CHECK(list.erase_after(list.begin(), list.end()) == list.end());
+    checkList(list, { 5 });
+    CHECK(c.live() == 1);
+    
+    /* Splicing between lists of one allocator allocates nothing */
+    
+    CountedList other = counted<CountedList>(c, { 10, 11, 12, 13 });
+    const size_t before = c.allocations;
+    
+    list.splice_after(list.cbefore_begin(), std::move(other), other.cbegin());
+    checkList(list, { 11, 5 });
+    checkList(other, { 10, 12, 13 });
+    
+    list.splice_after(list.cbegin(), std::move(other),
+                      other.cbefore_begin(), std::next(other.cbegin(), 2));
+    checkList(list, { 11, 10, 12, 5 });
+    checkList(other, { 13 });
+    
+    list.splice_after(std::next(list.cbegin(), 3), std::move(other));
+    checkList(list, { 11, 10, 12, 5, 13 });
+    checkList(other, {});
+    
+    CHECK(c.allocations == before);
+    
+    /* Between allocators the items are moved into new nodes */
+    
+    Counters d;
+    CountedList foreign = counted<CountedList>(d, { 20, 21 });
+    list.splice_after(list.cbefore_begin(), std::move(foreign));
+    checkList(list, { 20, 21, 11, 10, 12, 5, 13 });
+    CHECK(d.live() == 0);
+    CHECK(c.live() == list.size());
+    
+}
+
+void concatenationTest() {
+    
+    Counters c;
+    CountedList a = counted<CountedList>(c, { 1, 2 });
+    CountedList b = counted<CountedList>(c, { 3, 4, 5 });
+    
+    checkList(a + b, { 1, 2, 3, 4, 5 });
+    checkList(a.concatenate(b), { 1, 2, 3, 4, 5 });
+    checkList(a + counted<CountedList>(c, { 6 }), { 1, 2, 6 });
+    checkList(a.concatenate(counted<CountedList>(c, {})), { 1, 2 });
+    checkList(b, { 3, 4, 5 });
+    
+    /* Copy append allocates exactly the new nodes */
+    size_t before = c.allocations;
+    a.append(b);
+    CHECK(c.allocations == before + 3);
+    checkList(a, { 1, 2, 3, 4, 5 });
+    
+    a += a;
+    checkList(a, { 1, 2, 3, 4, 5, 1, 2, 3, 4, 5 });
+    
+    /* Move append splices */
+    CountedList empty{CountingAllocator<int>(c)};
+    before = c.allocations;
+    empty += std::move(b);
+    checkList(empty, { 3, 4, 5 });
+    checkList(b, {});
+    empty.append(counted<CountedList>(c, { 6 }));
+    CHECK(c.allocations == before + 1);
+    checkList(empty, { 3, 4, 5, 6 });
+    
+    CHECK(c.live() == a.size() + b.size() + empty.size());
+    
+}
+
+void assignmentTest() {
+    
+    Counters c;
+    CountedList src = counted<CountedList>(c, { 1, 2, 3 });
+    
+    /* Copy assignment reuses nodes, allocating only the missing ones */
+    
+    CountedList longer = counted<CountedList>(c, { 9, 9, 9, 9, 9 });
+    size_t before = c.allocations;
+    longer = src;
+    CHECK(c.allocations == before);
+    checkList(longer, { 1, 2, 3 });
+    
+    CountedList shorter = counted<CountedList>(c, { 9 });
+    before = c.allocations;
+    shorter.assign(src);
+    CHECK(c.allocations == before + 2);
+    checkList(shorter, { 1, 2, 3 });
+    
+    shorter = shorter;
+    checkList(shorter, { 1, 2, 3 });
+    
+    /* Move assignment frees the old nodes and allocates nothing */
+    
+    CountedList target = counted<CountedList>(c, { 7, 8 });
+    const size_t live = c.live();
+    before = c.allocations;
+    target = std::move(longer);
+    CHECK(c.allocations == before);
+    CHECK(c.live() == live - 2);
+    checkList(target, { 1, 2, 3 });
+    checkList(longer, {});
+    
+    target.assign(counted<CountedList>(c, { 4 }));
+    checkList(target, { 4 });
+    
+    /* Moving between allocators that propagate takes the allocator */
+    
+    Counters d;
+    CountedList other = counted<CountedList>(d, { 5, 6 });
+    target = std::move(other);
+    CHECK(target.get_allocator() == CountingAllocator<int>(d));
+    checkList(target, { 5, 6 });
+    
+    /* Strong guarantee, a throwing copy leaves the target untouched */
+    
+    List<Throwing> from;
+    List<Throwing> to;
+    for (int i = 0; i < 5; ++i) {
+        from.push_back(Throwing(i));
+    }
+    to.push_back(Throwing(42));
+    
+    Throwing::budget = 2;
+    CHECK_THROWS(to = from, std::runtime_error);
+    Throwing::budget = 2;
+    CHECK_THROWS(to.append(from), std::runtime_error);
+    Throwing::budget = -1;
+    checkList(to, { Throwing(42) });
+    
+}
+
+void swapTest() {
+    
+    Counters c;
+    CountedList a = counted<CountedList>(c, { 1, 2 });
+    CountedList b = counted<CountedList>(c, { 3 });
+    
+    const size_t before = c.allocations;
+    a.swap(b);
+    checkList(a, { 3 });
+    checkList(b, { 1, 2 });
+    swap(a, b);
+    checkList(a, { 1, 2 });
+    std::swap(a, b);
+    checkList(a, { 3 });
+    CHECK(c.allocations == before);
+    
+}
+
+void functionalTest() {
+    
+    List<int> list;
+    for (int i = 1; i <= 6; ++i) {
+        list.push_back(i);
+    }
+    
+    const auto strings = list.map([](const int i) { return std::to_string(i * i); });
+    static_assert(std::is_same_v<std::remove_cv_t<decltype(strings)>,
+                                 List<std::string>>);
+    checkList(strings, { "1", "4", "9", "16", "25", "36" });
+    
+    CHECK(list.fold([](int & acc, const int i) { acc += i; }, 0) == 21);
+    checkList(list.filter([](const int i) { return i % 2; }), { 1, 3, 5 });
+    
+    CHECK(list.remove_if([](const int i) { return i > 4; }) == 2);
+    checkList(list, { 1, 2, 3, 4 });
+    CHECK(list.retain([](const int i) { return i % 2 == 0; }) == 2);
+    checkList(list, { 2, 4 });
+    
+    checkList(List<int>().map([](const int i) { return i; }), {});
+    
+}
+
+void orderingTest() {
+    
+    Counters c;
+    CountedList list = counted<CountedList>(c, { 5, 3, 9, 1, 3, 7, 1 });
+    const size_t before = c.allocations;
+    
+    list.sort();
+    checkList(list, { 1, 1, 3, 3, 5, 7, 9 });
+    list.sort([](const int a, const int b) { return a > b; });
+    checkList(list, { 9, 7, 5, 3, 3, 1, 1 });
+    
+    CHECK(list.unique() == 2);
+    checkList(list, { 9, 7, 5, 3, 1 });
+    CHECK(list.unique([](const int a, const int b) { return a > b; }) == 4);
+    checkList(list, { 9 });
+    
+    list.reverse();
+    checkList(list, { 9 });
+    
+    CountedList other = counted<CountedList>(c, { 2, 8, 10 });
+    list.merge(std::move(other));
+    checkList(list, { 2, 8, 9, 10 });
+    checkList(other, {});
+    list.reverse();
+    checkList(list, { 10, 9, 8, 2 });
+    list.merge(counted<CountedList>(c, { 11, 3 }), [](const int a, const int b) { return a > b; });
+    checkList(list, { 11, 10, 9, 8, 3, 2 });
+    
+    CHECK(c.allocations == before + 5);
+    CHECK(c.live() == list.size());
+    
+    /* Sort is stable */
+    List<std::pair<int, int>> pairs;
+    for (int i = 0; i < 20; ++i) {
+        pairs.push_back(std::make_pair(i % 3, i));
+    }
+    pairs.sort([](const auto & a, const auto & b) { return a.first < b.first; });
+    CHECK(std::is_sorted(pairs.begin(), pairs.end()));
+    
+}
+
+void clearTest() {
+    
+    Counters c;
+    {
+        CountedList list = counted<CountedList>(c, { 1, 2, 3 });
+        list.clear();
+        checkList(list, {});
+        CHECK(c.live() == 0);
+        
+        list.push_back(4);
+        checkList(list, { 4 });
+        
+        CountedStrings strings{CountingAllocator<std::string>(c)};
+        strings.push_back(std::string(100, 'x'));
+    }
+    CHECK(c.live() == 0);
+    
+}
+
+int main() {
+    
+    constructionTest();
+    accessTest();
+    iteratorTest();
+    insertionTest();
+    removalTest();
+    afterIteratorTest();
+    concatenationTest();
+    assignmentTest();
+    swapTest();
+    functionalTest();
+    orderingTest();
+    clearTest();
+    std::cout << "list_test passed" << std::endl;
+    
+}
@@ -0,0 +1,114 @@
+//
+//  list_views_test.cpp
+//  linked_list
+//
+//  Tests for the lazy pipelines in list_views.hpp. Built with
+//  LINKED_LIST_INSTRUMENTATION, so the node counters show that a chain of
+//  views allocates nothing until it is collected.
+//
+//  Build: cmake --build <build dir> --target list_views_test && ctest
+//
+
+#ifndef LINKED_LIST_INSTRUMENTATION
+#define LINKED_LIST_INSTRUMENTATION
+#endif
+
+#include <iostream>
+#include <ranges>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "list.hpp"
+#include "list_views.hpp"
+#include "pool_allocator.hpp"
+#include "check.hpp"
+
+List<int> numbers(const int count) {
+    
+    List<int> list;
+    for (int i = 0; i < count; ++i) {
+        list.push_back(i);
+    }
+    return list;
+    
+}
+
+template<typename L>
+std::vector<typename L::value_type> items(const L & list) {
+    return std::vector<typename L::value_type>(list.begin(), list.end());
+}
+
+const auto isEven = [](const int i) { return i % 2 == 0; };
+const auto square = [](const int i) { return i * i; };
+const auto add = [](int & acc, const int i) { acc += i; };
+
+void foldTest() {
+    
+    const List<int> list = numbers(10);
+    list_stats.reset();
+    
+    const int sum = list | std::views::filter(isEven)
+                         | std::views::transform(square)
+                         | fold(add, 0);
+    
+    CHECK(sum == 0 + 4 + 16 + 36 + 64);
+    CHECK(list_stats.snapshot().nodesAllocated == 0);
+    
+    /* Matches the eager member functions */
+    CHECK(sum == list.filter(isEven).map(square).fold(add, 0));
+    
+    /* Only take(3) elements are visited */
+    size_t visited = 0;
+    const int firstThree = list | std::views::transform([&visited](const int i) {
+                                      ++visited;
+                                      return i;
+                                  })
+                                | std::views::take(3)
+                                | fold(add, 0);
+    CHECK(firstThree == 0 + 1 + 2);
+    CHECK(visited == 3);
+    
+}
+
+void toListTest() {
+    
+    List<int> list = numbers(10);
+    list_stats.reset();
+    
+    const List<int> evens = list | std::views::filter(isEven)
+                                 | std::views::transform(square)
+                                 | to_list();
+    
+    CHECK(items(evens) == std::vector<int>({ 0, 4, 16, 36, 64 }));
+    CHECK(list_stats.snapshot().nodesAllocated == 5);
+    
+    /* The value type follows the view */
+    const List<std::string> strings = list | std::views::take(3)
+                                           | std::views::transform([](const int i) {
+                                                 return std::to_string(i);
+                                             })
+                                           | to_list();
+    CHECK(items(strings) == std::vector<std::string>({ "0", "1", "2" }));
+    
+    /* Any input range collects, with the allocator rebound */
+    PoolAllocator<char> pool;
+    const auto pooled = std::views::iota(0, 4) | to_list(pool);
+    static_assert(std::is_same_v<decltype(pooled),
+                                 const List<int, PoolAllocator<int>>>);
+    CHECK(items(pooled) == std::vector<int>({ 0, 1, 2, 3 }));
+    
+    /* Views see changes made through the list */
+    auto view = list | std::views::filter(isEven);
+    list.first() = 100;
+    CHECK(*view.begin() == 100);
+    
+}
+
+int main() {
+    
+    foldTest();
+    toListTest();
+    std::cout << "list_views_test passed" << std::endl;
+    
+}
@@ -0,0 +1,112 @@
+//
+//  mpsc_queue_test.cpp
+//  linked_list
+//
+//  Multi-threaded stress test for MPSCQueue. Every producer pushes a
+//  numbered sequence, the consumer checks nothing is lost or duplicated
+//  and that each producer's items arrive in order.
+//
+//  Build: g++ -std=c++20 -O2 -pthread -I.. mpsc_queue_test.cpp -o mpsc_queue_test
+//
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+
+#include "list.hpp"
+#include "mpsc_queue.hpp"
+#include "check.hpp"
+
+struct Message {
+    size_t producer;
+    size_t seq;
+    std::string payload;
+};
+
+/* Consumer alternates try_pop and drain_into while producers run */
+void stressTest(const size_t producers, const size_t perProducer) {
+    
+    MPSCQueue<Message> queue;
+    std::vector<std::thread> threads;
+    
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p, perProducer]() {
+            for (size_t i = 0; i < perProducer; ++i) {
+                queue.emplace(Message { p, i, std::to_string(i) });
+            }
+        });
+    }
+    
+    std::vector<size_t> expected(producers, 0);
+    const auto check = [&expected](const Message & m) {
+        CHECK(m.producer < expected.size());
+        CHECK(m.seq == expected[m.producer]);
+        CHECK(m.payload == std::to_string(m.seq));
+        ++expected[m.producer];
+    };
+    
+    const size_t total = producers * perProducer;
+    size_t received = 0;
+    List<Message> batch;
+    
+    while (received < total) {
+        if (received % 2) {
+            if (auto m = queue.try_pop()) {
+                check(*m);
+                ++received;
+            }
+        } else {
+            received += queue.drain_into(batch);
+            for (const Message & m : batch) {
+                check(m);
+            }
+            batch.clear();
+        }
+    }
+    
+    for (std::thread & t : threads) {
+        t.join();
+    }
+    
+    CHECK(queue.empty());
+    CHECK(not queue.try_pop());
+    for (const size_t count : expected) {
+        CHECK(count == perProducer);
+    }
+    
+}
+
+/* Items still queued are destroyed with the queue */
+void leftoverTest() {
+    
+    MPSCQueue<std::string> queue;
+    CHECK(queue.empty());
+    for (int i = 0; i < 100; ++i) {
+        queue.push(std::string(64, 'a' + i % 26));
+    }
+    CHECK(not queue.empty());
+    CHECK(*queue.try_pop() == std::string(64, 'a'));
+    
+    List<std::string> list;
+    list.push_back("first");
+    CHECK(queue.drain_into(list) == 99);
+    CHECK(list.size() == 100);
+    CHECK(list.first() == "first");
+    CHECK(list.last() == std::string(64, 'a' + 99 % 26));
+    CHECK(queue.empty());
+    
+    queue.push("left over");
+    
+}
+
+int main() {
+    
+    leftoverTest();
+    for (const size_t producers : { 1, 2, 4, 8 }) {
+        stressTest(producers, 100000);
+    }
+    std::cout << "mpsc_queue_test passed" << std::endl;
+    
+}
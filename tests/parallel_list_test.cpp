@@ -0,0 +1,212 @@
+//
+//  parallel_list_test.cpp
+//  linked_list
+//
+//  Tests for parallel_list.hpp: par_map, par_fold and par_filter must give
+//  the same results, in the same order, as List's serial map, fold and
+//  filter, for lists that get one chunk or fewer items than threads as
+//  well as lists split across every thread, and exceptions thrown on a
+//  worker thread must reach the caller.
+//
+//  Build: cmake --build <build dir> --target parallel_list_test && ctest
+//
+
+#include <algorithm>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "list.hpp"
+#include "parallel_list.hpp"
+#include "pool_allocator.hpp"
+#include "arena_allocator.hpp"
+#include "check.hpp"
+
+List<int> numbers(const size_t count) {
+    
+    List<int> list;
+    for (size_t i = 0; i < count; ++i) {
+        list.push_back(int(i * 7919 % 10007));
+    }
+    return list;
+    
+}
+
+template<typename T, typename Alloc>
+std::vector<T> items(const List<T, Alloc> & list) {
+    return std::vector<T>(list.begin(), list.end());
+}
+
+/* Empty, fewer items than threads, one chunk, uneven chunks, more */
+/* chunks than a machine is likely to have cores                   */
+
+const std::vector<size_t> sizes = {
+    0, 1, 3, par_min_chunk - 1, par_min_chunk * 3 + 5, par_min_chunk * 16 + 1
+};
+
+const std::vector<size_t> threadCounts = { 0, 1, 2, 7, 16 };
+
+
+/********************************************************************/
+/*                                                                  */
+/*                              Tests                               */
+/*                                                                  */
+/********************************************************************/
+
+void mapTest() {
+    
+    const auto square = [](const int i) { return long(i) * i; };
+    const auto name = [](const int i) { return std::to_string(i); };
+    
+    for (const size_t size : sizes) {
+        const List<int> list = numbers(size);
+        for (const size_t threads : threadCounts) {
+            const List<long> squares = par_map(list, square, threads);
+            CHECK(squares.size() == size);
+            CHECK(items(squares) == items(list.map(square)));
+            
+            const List<std::string> names = par_map(list, name, threads);
+            CHECK(items(names) == items(list.map(name)));
+        }
+    }
+    
+}
+
+void foldTest() {
+    
+    const auto add = [](long & acc, const int i) { acc += i; };
+    const auto sum = [](long & acc, const long & part) { acc += part; };
+    
+    /* Concatenation is associative but not commutative, so any chunk */
+    /* combined out of order changes the result                        */
+    const auto write = [](std::string & acc, const int i) {
+        acc += std::to_string(i);
+        acc += ',';
+    };
+    const auto concat = [](std::string & acc, const std::string & part) {
+        acc += part;
+    };
+    
+    for (const size_t size : sizes) {
+        const List<int> list = numbers(size);
+        const long serialSum = list.fold(add, 0L);
+        const std::string serialText = list.fold(write, std::string());
+        for (const size_t threads : threadCounts) {
+            CHECK(par_fold(list, add, 0L, sum, threads) == serialSum);
+            CHECK(par_fold(list, write, std::string(), concat, threads) == serialText);
+        }
+    }
+    
+    /* An empty list folds to initVal */
+    CHECK(par_fold(List<int>(), add, 5L, sum, 4) == 5);
+    
+}
+
+void filterTest() {
+    
+    const auto even = [](const int i) { return i % 2 == 0; };
+    const auto none = [](const int) { return false; };
+    const auto all = [](const int) { return true; };
+    
+    for (const size_t size : sizes) {
+        const List<int> list = numbers(size);
+        for (const size_t threads : threadCounts) {
+            List<int> evens = par_filter(list, even, threads);
+            CHECK(items(evens) == items(list.filter(even)));
+            CHECK(par_filter(list, none, threads).size() == 0);
+            CHECK(items(par_filter(list, all, threads)) == items(list));
+            
+            /* The spliced result is an ordinary list */
+            evens.push_back(-1);
+            CHECK(evens.last() == -1);
+            CHECK(evens.size() == list.filter(even).size() + 1);
+        }
+    }
+    
+}
+
+void exceptionTest() {
+    
+    const List<int> list = numbers(par_min_chunk * 8);
+    const int last = list.last();
+    
+    /* Thrown on the last chunk's thread, not the calling one */
+    const auto throwing = [last](const int i) {
+        if (i == last) {
+            throw std::runtime_error("map");
+        }
+        return std::string(40, 'x');
+    };
+    CHECK_THROWS(par_map(list, throwing, 8), std::runtime_error);
+    
+    const auto failingTest = [last](const int i) {
+        if (i == last) {
+            throw std::logic_error("filter");
+        }
+        return true;
+    };
+    CHECK_THROWS(par_filter(list, failingTest, 8), std::logic_error);
+    
+    const auto failingAdd = [last](long & acc, const int i) {
+        if (i == last) {
+            throw std::runtime_error("fold");
+        }
+        acc += i;
+    };
+    const auto sum = [](long & acc, const long & part) { acc += part; };
+    CHECK_THROWS(par_fold(list, failingAdd, 0L, sum, 8), std::runtime_error);
+    
+}
+
+/* Pools and arenas are not thread safe. Run under the tsan preset, a */
+/* worker allocating from the input's pool shows up as a data race    */
+
+void allocatorTest() {
+    
+    const auto square = [](const int i) { return long(i) * i; };
+    const auto odd = [](const int i) { return i % 2 == 1; };
+    const size_t size = par_min_chunk * 8 + 3;
+    
+    PooledList<int> pooled;
+    std::pmr::monotonic_buffer_resource arena;
+    ArenaList<int> arenaList{ArenaAllocator<int>(arena)};
+    for (const int i : numbers(size)) {
+        pooled.push_back(i);
+        arenaList.push_back(i);
+    }
+    const std::vector<int> serial = items(numbers(size));
+    
+    /* The results use the input's allocator, rebound for map */
+    const PooledList<long> pooledSquares = par_map(pooled, square, 8);
+    CHECK(pooledSquares.get_allocator() == pooled.get_allocator());
+    CHECK(items(pooledSquares) == items(pooled.map(square)));
+    
+    const PooledList<int> pooledOdd = par_filter(pooled, odd, 8);
+    CHECK(pooledOdd.get_allocator() == pooled.get_allocator());
+    CHECK(items(pooledOdd) == items(pooled.filter(odd)));
+    
+    const ArenaList<long> arenaSquares = par_map(arenaList, square, 8);
+    CHECK(arenaSquares.get_allocator().arena() == &arena);
+    CHECK(items(arenaSquares) == items(arenaList.map(square)));
+    
+    const ArenaList<int> arenaOdd = par_filter(arenaList, odd, 8);
+    CHECK(arenaOdd.get_allocator().arena() == &arena);
+    CHECK(items(arenaOdd) == items(arenaList.filter(odd)));
+    
+    CHECK(items(pooled) == serial);
+    CHECK(items(arenaList) == serial);
+    
+}
+
+int main() {
+    
+    mapTest();
+    foldTest();
+    filterTest();
+    exceptionTest();
+    allocatorTest();
+    std::cout << "parallel_list_test passed" << std::endl;
+    
+}
@@ -0,0 +1,197 @@
+//
+//  pool_allocator_test.cpp
+//  linked_list
+//
+//  Tests for PoolAllocator and PooledList. Node addresses show which
+//  blocks the pool hands out, so the tests can check that freed nodes are
+//  reused, that copies share their source's pool, and that moves and
+//  swaps between lists with different pools carry the nodes along with
+//  the allocator instead of copying them.
+//
+//  Build: cmake --build <build dir> --target pool_allocator_test && ctest
+//
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <iostream>
+
+#include "list.hpp"
+#include "pool_allocator.hpp"
+#include "check.hpp"
+
+template<typename T>
+std::vector<T> items(const PooledList<T> & list) {
+    return std::vector<T>(list.begin(), list.end());
+}
+
+template<typename T>
+std::vector<const T *> addresses(const PooledList<T> & list) {
+    std::vector<const T *> result;
+    for (const T & item : list) {
+        result.push_back(&item);
+    }
+    return result;
+}
+
+PooledList<int> numbers(const std::shared_ptr<NodePoolResource> & resource,
+                        const int from,
+                        const int to) {
+    
+    PooledList<int> list{PoolAllocator<int>(resource)};
+    for (int i = from; i < to; ++i) {
+        list.push_back(i);
+    }
+    return list;
+    
+}
+
+
+/********************************************************************/
+/*                                                                  */
+/*                              Tests                               */
+/*                                                                  */
+/********************************************************************/
+
+void reuseTest() {
+    
+    const auto resource = std::make_shared<NodePoolResource>(4);
+    PooledList<int> list{PoolAllocator<int>(resource)};
+    
+    /* The free list is LIFO, a popped node is the next one handed out */
+    list.push_back(1).push_back(2);
+    const int * back = &list.last();
+    list.pop_back();
+    list.push_back(3);
+    CHECK(&list.last() == back);
+    
+    const int * front = &list.first();
+    list.pop_front();
+    list.push(4);
+    CHECK(&list.first() == front);
+    CHECK(items(list) == std::vector<int>({ 4, 3 }));
+    
+    /* A cleared list is rebuilt from the same blocks, across chunks */
+    for (int i = 0; i < 98; ++i) {
+        list.push_back(i);
+    }
+    const auto before = addresses(list);
+    const std::set<const int *> blocks(before.begin(), before.end());
+    CHECK(blocks.size() == 100);
+    
+    list.clear();
+    for (int i = 0; i < 100; ++i) {
+        list.push_back(i);
+    }
+    const auto after = addresses(list);
+    CHECK(std::set<const int *>(after.begin(), after.end()) == blocks);
+    
+    /* Other lists on the same resource draw from the same free list */
+    list.pop_front();
+    PooledList<int> other{PoolAllocator<int>(resource)};
+    other.push_back(7);
+    CHECK(&other.first() == after.front());
+    
+    /* Array allocations bypass the pool and refuse overflowing sizes */
+    PoolAllocator<int> allocator(resource);
+    int * array = allocator.allocate(16);
+    allocator.deallocate(array, 16);
+    CHECK_THROWS(allocator.allocate(allocator.max_size() + 1), std::bad_array_new_length);
+    
+}
+
+void copyTest() {
+    
+    const auto resource = std::make_shared<NodePoolResource>();
+    const PooledList<int> list = numbers(resource, 0, 10);
+    
+    /* select_on_container_copy_construction keeps the source's pool */
+    PooledList<int> copy(list);
+    CHECK(copy.get_allocator() == list.get_allocator());
+    CHECK(items(copy) == items(list));
+    
+    /* So the copy's freed nodes go back to the shared free list */
+    const int * freed = &copy.first();
+    copy.pop_front();
+    PooledList<int> third{PoolAllocator<int>(resource)};
+    third.push_back(42);
+    CHECK(&third.first() == freed);
+    
+    /* Rebound allocators share the resource too */
+    PoolAllocator<std::string> strings(list.get_allocator());
+    CHECK(strings == list.get_allocator());
+    
+    /* Copy assignment does not propagate, the target keeps its pool */
+    const auto otherResource = std::make_shared<NodePoolResource>();
+    PooledList<int> target = numbers(otherResource, 0, 3);
+    const PoolAllocator<int> targetAllocator = target.get_allocator();
+    target = list;
+    CHECK(target.get_allocator() == targetAllocator);
+    CHECK(not (target.get_allocator() == list.get_allocator()));
+    CHECK(items(target) == items(list));
+    
+    /* A default constructed allocator gets a pool of its own */
+    CHECK(not (PoolAllocator<int>() == PoolAllocator<int>()));
+    
+}
+
+void moveSwapTest() {
+    
+    const auto resourceA = std::make_shared<NodePoolResource>();
+    const auto resourceB = std::make_shared<NodePoolResource>();
+    
+    PooledList<int> a = numbers(resourceA, 0, 5);
+    PooledList<int> b = numbers(resourceB, 5, 8);
+    const PoolAllocator<int> allocatorA = a.get_allocator();
+    const PoolAllocator<int> allocatorB = b.get_allocator();
+    const auto nodesA = addresses(a);
+    const auto nodesB = addresses(b);
+    
+    /* Swap exchanges the allocators with the nodes */
+    a.swap(b);
+    CHECK(a.get_allocator() == allocatorB);
+    CHECK(b.get_allocator() == allocatorA);
+    CHECK(addresses(a) == nodesB);
+    CHECK(addresses(b) == nodesA);
+    CHECK(items(a) == std::vector<int>({ 5, 6, 7 }));
+    
+    /* Nodes keep going back to the pool they came from */
+    a.pop_front();
+    PooledList<int> fromB{PoolAllocator<int>(resourceB)};
+    fromB.push_back(0);
+    CHECK(&fromB.first() == nodesB.front());
+    
+    /* POCMA, move assignment takes over b's pool and nodes */
+    a = std::move(b);
+    CHECK(a.get_allocator() == allocatorA);
+    CHECK(addresses(a) == nodesA);
+    CHECK(items(a) == std::vector<int>({ 0, 1, 2, 3, 4 }));
+    CHECK(b.size() == 0);
+    
+    /* Move construction steals, the new list allocates from A's pool */
+    PooledList<int> moved(std::move(a));
+    CHECK(moved.get_allocator() == allocatorA);
+    CHECK(addresses(moved) == nodesA);
+    moved.push_back(5);
+    CHECK(items(moved) == std::vector<int>({ 0, 1, 2, 3, 4, 5 }));
+    
+    /* The resource lives as long as any allocator using it */
+    PooledList<int> last = numbers(std::make_shared<NodePoolResource>(), 0, 3);
+    PooledList<int> survivor = std::move(last);
+    survivor.push_back(3);
+    CHECK(items(survivor) == std::vector<int>({ 0, 1, 2, 3 }));
+    
+}
+
+int main() {
+    
+    reuseTest();
+    copyTest();
+    moveSwapTest();
+    std::cout << "pool_allocator_test passed" << std::endl;
+    
+}
@@ -0,0 +1,172 @@
+//
+//  small_list_test.cpp
+//  linked_list
+//
+//  Tests for SmallList. The global operator new is replaced with a counting
+//  one, so the tests can check that short lists never reach the heap and
+//  that items survive moves between lists whose nodes cannot move.
+//
+//  Build: g++ -std=c++20 -I.. small_list_test.cpp -o small_list_test
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <initializer_list>
+#include <new>
+#include <cstdlib>
+#include <utility>
+
+#include "list.hpp"
+#include "small_list.hpp"
+#include "check.hpp"
+
+size_t heapAllocations = 0;
+
+void * operator new(const size_t size) {
+    ++heapAllocations;
+    if (void * ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void * ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+/* Compares without allocating, so the counts stay exact */
+template<typename L>
+bool holds(const L & list, std::initializer_list<typename L::value_type> expected) {
+    return std::equal(list.begin(), list.end(), expected.begin(), expected.end());
+}
+
+static_assert(std::is_nothrow_move_constructible_v<List<int>>);
+static_assert(not std::is_nothrow_move_constructible_v<SmallList<int>>);
+
+void inlineTest() {
+    
+    heapAllocations = 0;
+    {
+        SmallList<int, 4> list;
+        list.push_back(1).push_back(2).push(0).push_back(3);
+        CHECK(holds(list, { 0, 1, 2, 3 }));
+        
+        /* Freed slots are reused */
+        list.pop_front();
+        list.remove(1);
+        list.push_back(4).push_back(5);
+        CHECK(holds(list, { 1, 3, 4, 5 }));
+        list.clear();
+        for (int i = 0; i < 4; ++i) {
+            list.push_back(i);
+        }
+        list.sort([](const int a, const int b) { return a > b; });
+        CHECK(holds(list, { 3, 2, 1, 0 }));
+    }
+    CHECK(heapAllocations == 0);
+    
+}
+
+void spillTest() {
+    
+    heapAllocations = 0;
+    {
+        SmallList<int, 4> list;
+        for (int i = 0; i < 10; ++i) {
+            list.push_back(i);
+        }
+        CHECK(heapAllocations == 6);
+        CHECK(holds(list, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+        
+        /* Heap nodes go back to the heap, slots to the list */
+        while (list.size() > 2) {
+            list.pop_back();
+        }
+        list.push_back(10).push_back(11);
+        CHECK(heapAllocations == 6);
+        CHECK(holds(list, { 0, 1, 10, 11 }));
+    }
+    
+}
+
+void moveTest() {
+    
+    SmallList<std::string, 2> a;
+    a.push_back("a").push_back("b").push_back("long enough to leave the SSO buffer");
+    
+    /* Moving moves the items into the new list's own storage */
+    SmallList<std::string, 2> b(std::move(a));
+    CHECK(a.size() == 0);
+    CHECK(holds(b, {
+        "a", "b", "long enough to leave the SSO buffer" }));
+    
+    SmallList<std::string, 2> c;
+    c.push_back("c");
+    c = std::move(b);
+    CHECK(b.size() == 0);
+    CHECK(c.size() == 3);
+    CHECK(c.last() == "long enough to leave the SSO buffer");
+    
+    swap(a, c);
+    CHECK(c.size() == 0);
+    CHECK(holds(a, {
+        "a", "b", "long enough to leave the SSO buffer" }));
+    
+    /* Lists of lists reallocate, which moves every small list */
+    std::vector<SmallList<int>> lists;
+    for (int i = 0; i < 32; ++i) {
+        lists.emplace_back();
+        lists.back().push_back(i).push_back(i + 1);
+    }
+    for (int i = 0; i < 32; ++i) {
+        CHECK(holds(lists[i], { i, i + 1 }));
+    }
+    
+}
+
+void copyTest() {
+    
+    SmallList<int, 4> list;
+    for (int i = 0; i < 6; ++i) {
+        list.push_back(i);
+    }
+    
+    SmallList<int, 4> copy(list);
+    list.first() = 100;
+    CHECK(holds(copy, { 0, 1, 2, 3, 4, 5 }));
+    
+    copy = list;
+    CHECK(holds(copy, { 100, 1, 2, 3, 4, 5 }));
+    
+    /* Results of map and filter get their own storage */
+    const auto doubled = list.map([](const int i) { return 2.0 * i; });
+    const auto odd = list.filter([](const int i) { return i % 2; });
+    list.clear();
+    CHECK(holds(doubled, { 200, 2, 4, 6, 8, 10 }));
+    CHECK(holds(odd, { 1, 3, 5 }));
+    
+    /* Lists with different storage exchange items, not nodes */
+    SmallList<int, 4> other;
+    other.push_back(7);
+    copy.splice_after(copy.cbefore_begin(), std::move(other));
+    copy.merge(SmallList<int, 4>(copy));
+    copy += SmallList<int, 4>(odd);
+    CHECK(copy.size() == 17);
+    
+}
+
+int main() {
+    
+    inlineTest();
+    spillTest();
+    moveTest();
+    copyTest();
+    std::cout << "small_list_test passed" << std::endl;
+    
+}
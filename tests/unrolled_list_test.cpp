@@ -0,0 +1,379 @@
+//
+//  unrolled_list_test.cpp
+//  linked_list
+//
+//  Unit tests for UnrolledList. A counting allocator counts the live
+//  blocks, so the tests can check where blocks split and merge, and that
+//  nothing leaks or stays linked when an item's constructor throws.
+//
+//  Build: cmake --build <build dir> --target unrolled_list_test && ctest
+//
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <iostream>
+
+#include "list.hpp"
+#include "unrolled_list.hpp"
+#include "fixtures.hpp"
+
+template<size_t N>
+using Counted = UnrolledList<int, N, CountingAllocator<int>>;
+
+/* Constructing from (value, true) throws */
+
+struct Fragile {
+    
+    int value = 0;
+    
+    Fragile(const int v, const bool fail = false) : value(v) {
+        if (fail) {
+            throw std::runtime_error("construct");
+        }
+    }
+    
+    bool operator==(const Fragile & other) const {
+        return value == other.value;
+    }
+    
+};
+
+static_assert(std::is_nothrow_move_constructible_v<UnrolledList<std::string>>);
+static_assert(std::is_nothrow_move_assignable_v<UnrolledList<std::string>>);
+static_assert(std::is_nothrow_swappable_v<UnrolledList<std::string>>);
+
+
+/********************************************************************/
+/*                                                                  */
+/*                              Tests                               */
+/*                                                                  */
+/********************************************************************/
+
+void splitTest() {
+    
+    Counters c;
+    {
+        /* Appending fills blocks, a full back block starts a new one */
+        Counted<4> list = counted<Counted<4>>(c, range(0, 8));
+        CHECK(c.live() == 2);
+        checkList(list, range(0, 8));
+        
+        /* Inserting into a full block splits it in halves */
+        list.insert(0, -1);
+        CHECK(c.live() == 3);
+        checkList(list, { -1, 0, 1, 2, 3, 4, 5, 6, 7 });
+        
+        /* Last index of the first half, the first half has room now */
+        list.insert(2, -2);
+        CHECK(c.live() == 3);
+        checkList(list, { -1, 0, -2, 1, 2, 3, 4, 5, 6, 7 });
+        
+        /* First item of the full back block, lands in the first half */
+        list.insert(6, -3);
+        CHECK(c.live() == 4);
+        checkList(list, { -1, 0, -2, 1, 2, 3, -3, 4, 5, 6, 7 });
+        
+        /* Last item of the full head block, lands in the second half */
+        list.insert(3, -4);
+        CHECK(c.live() == 5);
+        checkList(list, { -1, 0, -2, -4, 1, 2, 3, -3, 4, 5, 6, 7 });
+        
+        /* Pushing to a full head starts a new block in front */
+        Counted<4> front = counted<Counted<4>>(c, range(0, 4));
+        const size_t before = c.live();
+        front.push(-1);
+        CHECK(c.live() == before + 1);
+        checkList(front, { -1, 0, 1, 2, 3 });
+    }
+    CHECK(c.live() == 0);
+    
+}
+
+void mergeTest() {
+    
+    Counters c;
+    {
+        /* Blocks of 8 merge when they fit into 6 */
+        Counted<8> list = counted<Counted<8>>(c, range(0, 16));
+        CHECK(c.live() == 2);
+        
+        /* Removing from the first block's edge, 7 + 8 don't fit */
+        list.remove(7);
+        list.remove(0);
+        CHECK(c.live() == 2);
+        checkList(list, { 1, 2, 3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15 });
+        
+        for (int i = 0; i < 6; ++i) {
+            list.pop_back();
+        }
+        CHECK(c.live() == 2);
+        
+        /* 6 + 2 left, 5 + 2 still don't fit, 4 + 2 merge */
+        list.remove(0);
+        CHECK(c.live() == 2);
+        list.remove(0);
+        CHECK(c.live() == 1);
+        checkList(list, { 3, 4, 5, 6, 8, 9 });
+        
+        /* Emptied blocks are freed */
+        while (list.size()) {
+            list.pop_front();
+        }
+        CHECK(c.live() == 0);
+        checkList(list, {});
+        list.push_back(1);
+        checkList(list, { 1 });
+    }
+    CHECK(c.live() == 0);
+    
+}
+
+void singleItemTest() {
+    
+    Counters c;
+    {
+        Counted<1> list = counted<Counted<1>>(c, range(0, 5));
+        CHECK(c.live() == 5);
+        
+        list.insert(0, -1);
+        list.insert(3, -2);
+        list.push(-3);
+        list.push_back(5);
+        CHECK(c.live() == 9);
+        checkList(list, { -3, -1, 0, 1, -2, 2, 3, 4, 5 });
+        
+        CHECK(list.remove(4) == -2);
+        CHECK(list.pop_front() == -3);
+        CHECK(list.pop_back() == 5);
+        CHECK(c.live() == 6);
+        checkList(list, { -1, 0, 1, 2, 3, 4 });
+        
+        CHECK(list.remove_if([](const int i) { return i % 2; }) == 3);
+        CHECK(c.live() == 3);
+        checkList(list, { 0, 2, 4 });
+        
+        Counted<1> copy(list);
+        copy += list;
+        checkList(copy, { 0, 2, 4, 0, 2, 4 });
+        CHECK(c.live() == 9);
+    }
+    CHECK(c.live() == 0);
+    
+}
+
+void throwingConstructorTest() {
+    
+    /* Into an empty list, both ends */
+    UnrolledList<Fragile, 4> list;
+    CHECK_THROWS(list.emplace_back(1, true), std::runtime_error);
+    CHECK(list.size() == 0);
+    CHECK(list.begin() == list.end());
+    CHECK_THROWS(list.emplace_front(1, true), std::runtime_error);
+    CHECK(list.size() == 0);
+    CHECK(list.begin() == list.end());
+    CHECK_THROWS(list.first(), std::out_of_range);
+    
+    /* Onto full blocks, which would need a new block or a split */
+    for (int i = 0; i < 4; ++i) {
+        list.emplace_back(i);
+    }
+    CHECK_THROWS(list.emplace_back(9, true), std::runtime_error);
+    CHECK_THROWS(list.emplace_front(9, true), std::runtime_error);
+    CHECK_THROWS(list.emplace(1, 9, true), std::runtime_error);
+    CHECK(list.size() == 4);
+    CHECK(std::distance(list.begin(), list.end()) == 4);
+    CHECK(list.first() == Fragile(0));
+    CHECK(list.last() == Fragile(3));
+    
+    /* No blocks are left behind */
+    Counters c;
+    {
+        UnrolledList<Fragile, 4, CountingAllocator<Fragile>> counted{
+            CountingAllocator<Fragile>(c)};
+        CHECK_THROWS(counted.emplace_back(1, true), std::runtime_error);
+        CHECK(c.live() == 0);
+        for (int i = 0; i < 4; ++i) {
+            counted.emplace_back(i);
+        }
+        CHECK_THROWS(counted.emplace(0, 9, true), std::runtime_error);
+        CHECK_THROWS(counted.emplace_front(9, true), std::runtime_error);
+        CHECK(c.live() == 1);
+    }
+    CHECK(c.live() == 0);
+    
+}
+
+void throwingCopyTest() {
+    
+    Counters c;
+    {
+        typedef UnrolledList<Throwing, 4, CountingAllocator<Throwing>> Throwings;
+        
+        Throwings from{CountingAllocator<Throwing>(c)};
+        for (int i = 0; i < 10; ++i) {
+            from.push_back(Throwing(i));
+        }
+        const size_t live = c.live();
+        
+        /* Copy construction frees the blocks it built so far */
+        Throwing::budget = 6;
+        CHECK_THROWS(Throwings(from), std::runtime_error);
+        CHECK(c.live() == live);
+        
+        /* Assignment and append leave the target untouched */
+        Throwings to{CountingAllocator<Throwing>(c)};
+        to.push_back(Throwing(42));
+        Throwing::budget = 6;
+        CHECK_THROWS(to = from, std::runtime_error);
+        Throwing::budget = 6;
+        CHECK_THROWS(to.append(from), std::runtime_error);
+        Throwing::budget = -1;
+        checkList(to, { Throwing(42) });
+        CHECK(c.live() == live + 1);
+        
+        to = from;
+        CHECK(to.size() == 10);
+        CHECK(to.last() == Throwing(9));
+    }
+    CHECK(c.live() == 0);
+    
+}
+
+void appendTest() {
+    
+    Counters c;
+    {
+        Counted<4> a = counted<Counted<4>>(c, range(0, 6));
+        Counted<4> b = counted<Counted<4>>(c, range(6, 11));
+        
+        /* Moving in relinks the blocks */
+        const size_t allocations = c.allocations;
+        a += std::move(b);
+        CHECK(c.allocations == allocations);
+        checkList(a, range(0, 11));
+        checkList(b, {});
+        
+        a.append(std::move(a));
+        checkList(a, range(0, 11));
+        
+        /* Copies pack the items into full blocks */
+        a += a;
+        std::vector<int> twice = range(0, 11);
+        const std::vector<int> once = twice;
+        twice.insert(twice.end(), once.begin(), once.end());
+        checkList(a, twice);
+        
+        const Counted<4> small = counted<Counted<4>>(c, { 1, 2 });
+        checkList(small + counted<Counted<4>>(c, { 3 }), { 1, 2, 3 });
+        checkList(small.concatenate(small), { 1, 2, 1, 2 });
+        
+        /* Lists with other allocators exchange items, not blocks */
+        Counters d;
+        Counted<4> other = counted<Counted<4>>(d, range(0, 5));
+        Counted<4> target = counted<Counted<4>>(c, { -1 });
+        target.append(std::move(other));
+        checkList(target, { -1, 0, 1, 2, 3, 4 });
+        checkList(other, {});
+        CHECK(d.live() == 0);
+    }
+    CHECK(c.live() == 0);
+    
+}
+
+void removeIfTest() {
+    
+    Counters c;
+    {
+        Counted<4> list = counted<Counted<4>>(c, range(0, 20));
+        CHECK(list.remove_if([](const int i) { return i % 4 != 0; }) == 15);
+        checkList(list, { 0, 4, 8, 12, 16 });
+        
+        /* One item per block was left, they merge into two blocks */
+        CHECK(c.live() == 2);
+        
+        CHECK(list.retain([](const int i) { return i > 4; }) == 2);
+        checkList(list, { 8, 12, 16 });
+        CHECK(list.remove_if([](const int) { return true; }) == 3);
+        checkList(list, {});
+        CHECK(c.live() == 0);
+        CHECK(list.remove_if([](const int) { return true; }) == 0);
+        
+        /* A throwing predicate leaves a consistent list */
+        Counted<4> partial = counted<Counted<4>>(c, range(0, 10));
+        int calls = 0;
+        CHECK_THROWS(partial.remove_if([&calls](const int i) {
+            if (++calls == 7) {
+                throw std::runtime_error("predicate");
+            }
+            return i % 2 == 0;
+        }), std::runtime_error);
+        checkList(partial, { 1, 3, 5, 6, 7, 8, 9 });
+    }
+    CHECK(c.live() == 0);
+    
+}
+
+void swapTest() {
+    
+    Counters c;
+    Counted<4> a = counted<Counted<4>>(c, range(0, 6));
+    Counted<4> b = counted<Counted<4>>(c, { 9 });
+    
+    const size_t allocations = c.allocations;
+    a.swap(b);
+    checkList(a, { 9 });
+    checkList(b, range(0, 6));
+    swap(a, b);
+    checkList(a, range(0, 6));
+    std::swap(a, b);
+    checkList(a, { 9 });
+    CHECK(c.allocations == allocations);
+    
+}
+
+void functionalTest() {
+    
+    UnrolledList<int> list;
+    for (int i = 0; i < 40; ++i) {
+        list.push_back(i);
+    }
+    list.insert(20, -1);
+    CHECK(list.remove(0) == 0);
+    CHECK(list.pop_back() == 39);
+    CHECK(list.size() == 39);
+    CHECK(list[19] == -1);
+    
+    const auto evens = list.filter([](const int i) { return i % 2 == 0; });
+    CHECK(evens.size() == 19);
+    CHECK(evens.first() == 2);
+    CHECK(evens.last() == 38);
+    
+    const auto sum = [](long & acc, const int i) { acc += i; };
+    CHECK(list.fold(sum, 0L) == 38 * 39 / 2 - 1);
+    
+    const auto halves = list.map([](const int i) { return i / 2.0; });
+    CHECK(halves.size() == list.size());
+    CHECK(halves[0] == 0.5);
+    CHECK(halves.last() == 19.0);
+    
+}
+
+int main() {
+    
+    splitTest();
+    mergeTest();
+    singleItemTest();
+    throwingConstructorTest();
+    throwingCopyTest();
+    appendTest();
+    removeIfTest();
+    swapTest();
+    functionalTest();
+    std::cout << "unrolled_list_test passed" << std::endl;
+    
+}
@@ -0,0 +1,1326 @@
+//
+//  unrolled_list.hpp
+//  linked_list
+//
+//  Unrolled linked list, each block stores up to N items contiguously next
+//  to its links. By default N is chosen so a block of small items fits a
+//  64 byte cache line, which cuts the per-item pointer overhead of List<T>
+//  and turns most traversal steps into sequential reads.
+//
+
+#ifndef unrolled_list_hpp
+#define unrolled_list_hpp
+
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <stdexcept>
+#include <iterator>
+#include <functional>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
+#include "list.hpp"
+
+
+/*************************************************************************/
+/*                                                                       */
+/* ********************************************************************* */
+/* **************************** Declaration **************************** */
+/* ********************************************************************* */
+/*                                                                       */
+/*************************************************************************/
+
+
+/* Items per block so that a block of small items fills a cache line */
+
+template<typename T>
+inline constexpr size_t unrolled_block_capacity =
+    sizeof(T) + 3 * sizeof(void *) >= 64
+        ? 1
+        : (64 - 3 * sizeof(void *)) / sizeof(T);
+
+template <typename T,
+          size_t N = unrolled_block_capacity<T>,
+          typename Alloc = std::allocator<T>>
+class UnrolledList {
+    
+    static_assert(N > 0, "UnrolledList blocks must hold at least one item");
+    static_assert(not allocator_stores_nodes_inline<Alloc>::value,
+                  "UnrolledList moves blocks between lists, use List for inline storage");
+    
+    struct Block {
+        
+        Block * prev = nullptr;
+        Block * next = nullptr;
+        size_t count = 0;
+        alignas(T) std::byte storage[N * sizeof(T)];
+        
+        /* User provided, so value initialization leaves storage alone */
+        Block() { }
+        
+        T * items();
+        const T * items() const;
+        
+    };
+    
+    typedef Block* block_ptr;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Block>
+        block_allocator;
+    typedef std::allocator_traits<block_allocator> block_traits;
+    
+    template<typename, size_t, typename> friend class UnrolledList;
+    
+    size_t len = 0;
+    block_ptr head = nullptr;
+    block_ptr back = nullptr;
+    [[no_unique_address]] block_allocator alloc;
+    
+    /* Block allocation and linking */
+    
+    block_ptr create_block();
+    void destroy_block(block_ptr block);
+    void link_block_after(block_ptr pos, block_ptr block);
+    void unlink_block(block_ptr block);
+    
+    /* A new unlinked block holding one item, freed if T throws */
+    
+    template<typename... args>
+    block_ptr create_block_with(args&&... a);
+    
+    /* Chain copying, copy_chain() packs the items of the blocks from */
+    /* first on into full blocks and frees its partial copy if T throws */
+    
+    block_ptr copy_chain(block_ptr first, block_ptr & last);
+    void destroy_chain(block_ptr first);
+    
+    /* Item retrieval */
+    
+    std::pair<block_ptr, size_t> locate(const size_t index) const;
+    
+    /* Utility */
+    
+    void checkIndexRange(const size_t index) const;
+    void steal(UnrolledList<T, N, Alloc> & l);
+    bool shares_allocator(const UnrolledList<T, N, Alloc> & l) const;
+    
+    /* Item insertion and removal within a block */
+    
+    template<typename... args>
+    T & emplace_at(block_ptr block, size_t offset, args&&... a);
+    T remove_at(block_ptr block, const size_t offset);
+    void merge_next(block_ptr block);
+    
+    /* Iterators */
+    
+    template<bool Const>
+    class Iterator {
+        
+        friend class UnrolledList;
+        template<bool> friend class Iterator;
+        
+        block_ptr block = nullptr;
+        size_t offset = 0;
+        
+        Iterator(block_ptr block, const size_t offset);
+        
+    public:
+        
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::forward_iterator_tag iterator_concept;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::conditional_t<Const, const T, T> * pointer;
+        typedef std::conditional_t<Const, const T, T> & reference;
+        
+        Iterator() = default;
+        
+        template<bool OtherConst> requires (Const and not OtherConst)
+        Iterator(const Iterator<OtherConst> & it);
+        
+        reference operator*() const;
+        pointer operator->() const;
+        
+        Iterator & operator++();
+        Iterator operator++(int);
+        
+        bool operator==(const Iterator & other) const;
+        
+    };
+    
+public:
+    
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef T & reference;
+    typedef const T & const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+    
+    static constexpr size_t block_capacity = N;
+    
+    /* Allocator */
+    
+    allocator_type get_allocator() const;
+    
+    /* Iterators */
+    
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator cbegin() const;
+    const_iterator cend() const;
+    
+    /* Element access */
+    
+    T & at(const size_t index);
+    T & operator[](const size_t index);
+    const T & at(const size_t index) const;
+    const T & operator[](const size_t index) const;
+    
+    T & first();
+    const T & first() const;
+    
+    T & last();
+    const T & last() const;
+    
+    /* Push back */
+    
+    UnrolledList<T, N, Alloc> & push_back(const T & item);
+    UnrolledList<T, N, Alloc> & push_back(T && item);
+    
+    template<typename... args>
+    requires std::constructible_from<T, args&&...>
+    UnrolledList<T, N, Alloc> & push_back(args&&... a);
+    
+    template<typename... args>
+    T & emplace_back(args&&... a);
+    
+    /* Push front */
+    
+    UnrolledList<T, N, Alloc> & push(const T & item);
+    UnrolledList<T, N, Alloc> & push(T && item);
+    
+    template<typename... args>
+    requires std::constructible_from<T, args&&...>
+    UnrolledList<T, N, Alloc> & push(args&&... a);
+    
+    template<typename... args>
+    T & emplace_front(args&&... a);
+    
+    /* Insert at index */
+    
+    UnrolledList<T, N, Alloc> & insert(const size_t index, const T & item);
+    UnrolledList<T, N, Alloc> & insert(const size_t index, T && item);
+    
+    template<typename... args>
+    requires std::constructible_from<T, args&&...>
+    UnrolledList<T, N, Alloc> & insert(const size_t index, args&&... a);
+    
+    template<typename... args>
+    T & emplace(const size_t index, args&&... a);
+    
+    /* Remove elements */
+    
+    T pop_front();
+    T pop_back();
+    T remove(const size_t index);
+    
+    /* List concatenation */
+    
+    UnrolledList<T, N, Alloc> concatenate(const UnrolledList<T, N, Alloc> & l) const;
+    UnrolledList<T, N, Alloc> operator+(const UnrolledList<T, N, Alloc> & l) const;
+    UnrolledList<T, N, Alloc> concatenate(UnrolledList<T, N, Alloc> && l) const;
+    UnrolledList<T, N, Alloc> operator+(UnrolledList<T, N, Alloc> && l) const;
+    
+    /* Append list */
+    
+    UnrolledList<T, N, Alloc> & append(const UnrolledList<T, N, Alloc> & l);
+    UnrolledList<T, N, Alloc> & operator+=(const UnrolledList<T, N, Alloc> & l);
+    UnrolledList<T, N, Alloc> & append(UnrolledList<T, N, Alloc> && l);
+    UnrolledList<T, N, Alloc> & operator+=(UnrolledList<T, N, Alloc> && l);
+    
+    /* Assignment */
+    
+    UnrolledList<T, N, Alloc> & assign(const UnrolledList<T, N, Alloc> & l);
+    UnrolledList<T, N, Alloc> & operator=(const UnrolledList<T, N, Alloc> & l);
+    UnrolledList<T, N, Alloc> & assign(UnrolledList<T, N, Alloc> && l)
+        noexcept(block_traits::propagate_on_container_move_assignment::value or
+                 block_traits::is_always_equal::value);
+    UnrolledList<T, N, Alloc> & operator=(UnrolledList<T, N, Alloc> && l)
+        noexcept(block_traits::propagate_on_container_move_assignment::value or
+                 block_traits::is_always_equal::value);
+    
+    void swap(UnrolledList<T, N, Alloc> & l) noexcept;
+    
+    /* Utility */
+    
+    size_t size() const;
+    
+    template<typename Fun,
+             typename U = std::remove_cvref_t<
+                 std::invoke_result_t<Fun &, const T &>>>
+    requires std::invocable<Fun &, const T &>
+    UnrolledList<U, unrolled_block_capacity<U>,
+                 typename std::allocator_traits<Alloc>::template rebind_alloc<U>>
+    map(Fun fun) const;
+    
+    template<typename Acc, typename Fun>
+    requires std::invocable<Fun &, Acc &, const T &>
+    Acc fold(Fun fun, Acc initVal) const;
+    
+    template<typename Fun>
+    requires std::predicate<Fun &, const T &>
+    UnrolledList<T, N, Alloc> filter(Fun fun) const;
+    
+    template<typename Fun>
+    requires std::predicate<Fun &, const T &>
+    size_t remove_if(Fun fun);
+    
+    template<typename Fun>
+    requires std::predicate<Fun &, const T &>
+    size_t retain(Fun fun);
+    
+    UnrolledList<T, N, Alloc> & clear();
+    
+    /* Constructors */
+    
+    UnrolledList();
+    explicit UnrolledList(const Alloc & allocator);
+    UnrolledList(const UnrolledList<T, N, Alloc> & orig);
+    UnrolledList(UnrolledList<T, N, Alloc> && orig) noexcept;
+    
+    /* Destructor */
+    
+    ~UnrolledList();
+    
+};
+
+template<typename T, size_t N, typename Alloc>
+void swap(UnrolledList<T, N, Alloc> & lhs, UnrolledList<T, N, Alloc> & rhs) noexcept;
+
+/**************************************************************************/
+/*                                                                        */
+/* ********************************************************************** */
+/* *************************** Implementation *************************** */
+/* ********************************************************************** */
+/*                                                                        */
+/**************************************************************************/
+
+
+/********************************************************************/
+/*                                                                  */
+/*                              Block                               */
+/*                                                                  */
+/********************************************************************/
+
+template<typename T, size_t N, typename Alloc>
+T * UnrolledList<T, N, Alloc>::Block::items() {
+    return std::launder(reinterpret_cast<T *>(storage));
+}
+
+template<typename T, size_t N, typename Alloc>
+const T * UnrolledList<T, N, Alloc>::Block::items() const {
+    return std::launder(reinterpret_cast<const T *>(storage));
+}
+
+
+/********************************************************************/
+/*                                                                  */
+/*                             Iterator                             */
+/*                                                                  */
+/********************************************************************/
+
+template<typename T, size_t N, typename Alloc>
+template<bool Const>
+UnrolledList<T, N, Alloc>::Iterator<Const>::Iterator(block_ptr block,
+                                                     const size_t offset)
+    : block(block), offset(offset) { }
+
+template<typename T, size_t N, typename Alloc>
+template<bool Const>
+template<bool OtherConst> requires (Const and not OtherConst)
+UnrolledList<T, N, Alloc>::Iterator<Const>::Iterator(const Iterator<OtherConst> & it)
+    : block(it.block), offset(it.offset) { }
+
+template<typename T, size_t N, typename Alloc>
+template<bool Const>
+typename UnrolledList<T, N, Alloc>::template Iterator<Const>::reference
+UnrolledList<T, N, Alloc>::Iterator<Const>::operator*() const {
+    return block->items()[offset];
+}
+
+template<typename T, size_t N, typename Alloc>
+template<bool Const>
+typename UnrolledList<T, N, Alloc>::template Iterator<Const>::pointer
+UnrolledList<T, N, Alloc>::Iterator<Const>::operator->() const {
+    return block->items() + offset;
+}
+
+template<typename T, size_t N, typename Alloc>
+template<bool Const>
+typename UnrolledList<T, N, Alloc>::template Iterator<Const> &
+UnrolledList<T, N, Alloc>::Iterator<Const>::operator++() {
+    if (++offset == block->count) {
+        block = block->next;
+        offset = 0;
+    }
+    return *this;
+}
+
+template<typename T, size_t N, typename Alloc>
+template<bool Const>
+typename UnrolledList<T, N, Alloc>::template Iterator<Const>
+UnrolledList<T, N, Alloc>::Iterator<Const>::operator++(int) {
+    Iterator copy = *this;
+    ++*this;
+    return copy;
+}
+
+template<typename T, size_t N, typename Alloc>
+template<bool Const>
+bool UnrolledList<T, N, Alloc>::Iterator<Const>::operator==(const Iterator & other) const {
+    return block == other.block and offset == other.offset;
+}
+
+
+/*********************************************************************/
+/*                                                                   */
+/*                     UnrolledList<T, N, Alloc>                     */
+/*                                                                   */
+/*********************************************************************/
+
+/**********************/
+/*      Internal      */
+/**********************/
+
+/* Block allocation and linking */
+
+template<typename T, size_t N, typename Alloc>
+typename UnrolledList<T, N, Alloc>::block_ptr
+UnrolledList<T, N, Alloc>::create_block() {
+    
+    block_ptr block = block_traits::allocate(alloc, 1);
+    block_traits::construct(alloc, block);
+    return block;
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+void UnrolledList<T, N, Alloc>::destroy_block(block_ptr block) {
+    block_traits::destroy(alloc, block);
+    block_traits::deallocate(alloc, block, 1);
+}
+
+template<typename T, size_t N, typename Alloc>
+template<typename... args>
+typename UnrolledList<T, N, Alloc>::block_ptr
+UnrolledList<T, N, Alloc>::create_block_with(args&&... a) {
+    
+    block_ptr block = create_block();
+    try {
+        std::construct_at(block->items(), std::forward<args>(a)...);
+    } catch (...) {
+        destroy_block(block);
+        throw;
+    }
+    block->count = 1;
+    return block;
+    
+}
+
+/* Chain copying */
+
+template<typename T, size_t N, typename Alloc>
+typename UnrolledList<T, N, Alloc>::block_ptr
+UnrolledList<T, N, Alloc>::copy_chain(block_ptr first, block_ptr & last) {
+    
+    block_ptr copy = nullptr;
+    last = nullptr;
+    
+    try {
+        for (; first != nullptr; first = first->next) {
+            const T * from = first->items();
+            for (size_t i = 0; i < first->count; ++i) {
+                if (last == nullptr or last->count == N) {
+                    block_ptr block = create_block();
+                    block->prev = last;
+                    if (last) {
+                        last->next = block;
+                    } else {
+                        copy = block;
+                    }
+                    last = block;
+                }
+                std::construct_at(last->items() + last->count, from[i]);
+                ++last->count;
+            }
+        }
+    } catch (...) {
+        destroy_chain(copy);
+        throw;
+    }
+    
+    return copy;
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+void UnrolledList<T, N, Alloc>::destroy_chain(block_ptr first) {
+    while (first != nullptr) {
+        block_ptr next = first->next;
+        std::destroy_n(first->items(), first->count);
+        destroy_block(first);
+        first = next;
+    }
+}
+
+/* Links block after pos, or in front of the list if pos is null */
+
+template<typename T, size_t N, typename Alloc>
+void UnrolledList<T, N, Alloc>::link_block_after(block_ptr pos, block_ptr block) {
+    
+    block->prev = pos;
+    block->next = pos ? pos->next : head;
+    
+    if (block->next) {
+        block->next->prev = block;
+    } else {
+        back = block;
+    }
+    
+    if (pos) {
+        pos->next = block;
+    } else {
+        head = block;
+    }
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+void UnrolledList<T, N, Alloc>::unlink_block(block_ptr block) {
+    
+    if (block->prev) {
+        block->prev->next = block->next;
+    } else {
+        head = block->next;
+    }
+    
+    if (block->next) {
+        block->next->prev = block->prev;
+    } else {
+        back = block->prev;
+    }
+    
+}
+
+/* Item retrieval, walks blocks from whichever end is closer */
+
+template<typename T, size_t N, typename Alloc>
+std::pair<typename UnrolledList<T, N, Alloc>::block_ptr, size_t>
+UnrolledList<T, N, Alloc>::locate(const size_t index) const {
+    
+    if (index < len / 2) {
+        size_t offset = index;
+        block_ptr block = head;
+        while (offset >= block->count) {
+            offset -= block->count;
+            block = block->next;
+        }
+        return { block, offset };
+    }
+    
+    size_t remaining = len - index;
+    block_ptr block = back;
+    while (remaining > block->count) {
+        remaining -= block->count;
+        block = block->prev;
+    }
+    return { block, block->count - remaining };
+    
+}
+
+/* Utility */
+
+template<typename T, size_t N, typename Alloc>
+void UnrolledList<T, N, Alloc>::checkIndexRange(const size_t index) const {
+    if (index >= len) {
+        throw std::out_of_range("List index out of range.");
+    }
+}
+
+template<typename T, size_t N, typename Alloc>
+void UnrolledList<T, N, Alloc>::steal(UnrolledList<T, N, Alloc> & l) {
+    
+    head = l.head;
+    back = l.back;
+    len = l.len;
+    
+    l.head = nullptr;
+    l.back = nullptr;
+    l.len = 0;
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+bool UnrolledList<T, N, Alloc>::shares_allocator(const UnrolledList<T, N, Alloc> & l) const {
+    if constexpr (block_traits::is_always_equal::value) {
+        return true;
+    } else {
+        return alloc == l.alloc;
+    }
+}
+
+/* Item insertion and removal within a block */
+
+template<typename T, size_t N, typename Alloc>
+template<typename... args>
+T & UnrolledList<T, N, Alloc>::emplace_at(block_ptr block,
+                                          size_t offset,
+                                          args&&... a) {
+    
+    if (offset == block->count and block->count < N) {
+        std::construct_at(block->items() + offset, std::forward<args>(a)...);
+        ++block->count;
+        ++len;
+        return block->items()[offset];
+    }
+    
+    /* Built before any item or block moves, so a throwing constructor */
+    /* leaves the list as it was                                       */
+    T item(std::forward<args>(a)...);
+    
+    /* Split a full block in halves and insert into the matching half */
+    if (block->count == N) {
+        
+        block_ptr half = create_block();
+        const size_t keep = N / 2;
+        
+        T * from = block->items();
+        T * to = half->items();
+        for (size_t i = keep; i < N; ++i) {
+            std::construct_at(to + i - keep, std::move(from[i]));
+            std::destroy_at(from + i);
+        }
+        half->count = N - keep;
+        block->count = keep;
+        link_block_after(block, half);
+        
+        if (offset > keep) {
+            offset -= keep;
+            block = half;
+        }
+        
+    }
+    
+    T * items = block->items();
+    for (size_t i = block->count; i > offset; --i) {
+        std::construct_at(items + i, std::move(items[i - 1]));
+        std::destroy_at(items + i - 1);
+    }
+    std::construct_at(items + offset, std::move(item));
+    
+    ++block->count;
+    ++len;
+    return items[offset];
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+T UnrolledList<T, N, Alloc>::remove_at(block_ptr block, const size_t offset) {
+    
+    T * items = block->items();
+    T retval(std::move(items[offset]));
+    std::destroy_at(items + offset);
+    
+    for (size_t i = offset + 1; i < block->count; ++i) {
+        std::construct_at(items + i - 1, std::move(items[i]));
+        std::destroy_at(items + i);
+    }
+    --block->count;
+    --len;
+    
+    if (block->count == 0) {
+        unlink_block(block);
+        destroy_block(block);
+        return retval;
+    }
+    
+    merge_next(block);
+    return retval;
+    
+}
+
+/* Merges sparse neighbours, leaving some room so the merged block */
+/* does not split again on the next insertion                      */
+
+template<typename T, size_t N, typename Alloc>
+void UnrolledList<T, N, Alloc>::merge_next(block_ptr block) {
+    
+    block_ptr next = block->next;
+    if (next == nullptr or block->count + next->count > N - N / 4) {
+        return;
+    }
+    
+    T * items = block->items();
+    T * from = next->items();
+    for (size_t i = 0; i < next->count; ++i) {
+        std::construct_at(items + block->count + i, std::move(from[i]));
+        std::destroy_at(from + i);
+    }
+    block->count += next->count;
+    unlink_block(next);
+    destroy_block(next);
+    
+}
+
+/**********************/
+/*       Public       */
+/**********************/
+
+/* Allocator */
+
+template<typename T, size_t N, typename Alloc>
+typename UnrolledList<T, N, Alloc>::allocator_type
+UnrolledList<T, N, Alloc>::get_allocator() const {
+    return allocator_type(alloc);
+}
+
+/* Iterators */
+
+template<typename T, size_t N, typename Alloc>
+typename UnrolledList<T, N, Alloc>::iterator UnrolledList<T, N, Alloc>::begin() {
+    return iterator(head, 0);
+}
+
+template<typename T, size_t N, typename Alloc>
+typename UnrolledList<T, N, Alloc>::iterator UnrolledList<T, N, Alloc>::end() {
+    return iterator(nullptr, 0);
+}
+
+template<typename T, size_t N, typename Alloc>
+typename UnrolledList<T, N, Alloc>::const_iterator
+UnrolledList<T, N, Alloc>::begin() const {
+    return const_iterator(head, 0);
+}
+
+template<typename T, size_t N, typename Alloc>
+typename UnrolledList<T, N, Alloc>::const_iterator
+UnrolledList<T, N, Alloc>::end() const {
+    return const_iterator(nullptr, 0);
+}
+
+template<typename T, size_t N, typename Alloc>
+typename UnrolledList<T, N, Alloc>::const_iterator
+UnrolledList<T, N, Alloc>::cbegin() const {
+    return begin();
+}
+
+template<typename T, size_t N, typename Alloc>
+typename UnrolledList<T, N, Alloc>::const_iterator
+UnrolledList<T, N, Alloc>::cend() const {
+    return end();
+}
+
+/* Element access */
+
+template<typename T, size_t N, typename Alloc>
+T & UnrolledList<T, N, Alloc>::at(const size_t index) {
+    checkIndexRange(index);
+    const auto [block, offset] = locate(index);
+    return block->items()[offset];
+}
+
+template<typename T, size_t N, typename Alloc>
+T & UnrolledList<T, N, Alloc>::operator[](const size_t index) {
+    return at(index);
+}
+
+template<typename T, size_t N, typename Alloc>
+const T & UnrolledList<T, N, Alloc>::at(const size_t index) const {
+    checkIndexRange(index);
+    const auto [block, offset] = locate(index);
+    return block->items()[offset];
+}
+
+template<typename T, size_t N, typename Alloc>
+const T & UnrolledList<T, N, Alloc>::operator[](const size_t index) const {
+    return at(index);
+}
+
+template<typename T, size_t N, typename Alloc>
+T & UnrolledList<T, N, Alloc>::first() {
+    
+    if (head == nullptr) {
+        throw std::out_of_range("Calling UnrolledList<T>::first() on an empty "
+                                "UnrolledList");
+    }
+    
+    return head->items()[0];
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+const T & UnrolledList<T, N, Alloc>::first() const {
+    
+    if (head == nullptr) {
+        throw std::out_of_range("Calling UnrolledList<T>::first() on an empty "
+                                "UnrolledList");
+    }
+    
+    return head->items()[0];
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+T & UnrolledList<T, N, Alloc>::last() {
+    
+    if (back == nullptr) {
+        throw std::out_of_range("Calling UnrolledList<T>::last() on an empty "
+                                "UnrolledList");
+    }
+    
+    return back->items()[back->count - 1];
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+const T & UnrolledList<T, N, Alloc>::last() const {
+    
+    if (back == nullptr) {
+        throw std::out_of_range("Calling UnrolledList<T>::last() on an empty "
+                                "UnrolledList");
+    }
+    
+    return back->items()[back->count - 1];
+    
+}
+
+/* Item insertion */
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> & UnrolledList<T, N, Alloc>::push_back(const T & item) {
+    emplace_back(item);
+    return *this;
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> & UnrolledList<T, N, Alloc>::push_back(T && item) {
+    emplace_back(std::move(item));
+    return *this;
+}
+
+template<typename T, size_t N, typename Alloc>
+template<typename... args>
+requires std::constructible_from<T, args&&...>
+UnrolledList<T, N, Alloc> & UnrolledList<T, N, Alloc>::push_back(args&&... a) {
+    emplace_back(std::forward<args>(a)...);
+    return *this;
+}
+
+/* Appending to a full last block starts a new one instead of splitting */
+
+template<typename T, size_t N, typename Alloc>
+template<typename... args>
+T & UnrolledList<T, N, Alloc>::emplace_back(args&&... a) {
+    
+    if (back == nullptr or back->count == N) {
+        link_block_after(back, create_block_with(std::forward<args>(a)...));
+        ++len;
+        return back->items()[0];
+    }
+    
+    return emplace_at(back, back->count, std::forward<args>(a)...);
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> & UnrolledList<T, N, Alloc>::push(const T & item) {
+    emplace_front(item);
+    return *this;
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> & UnrolledList<T, N, Alloc>::push(T && item) {
+    emplace_front(std::move(item));
+    return *this;
+}
+
+template<typename T, size_t N, typename Alloc>
+template<typename... args>
+requires std::constructible_from<T, args&&...>
+UnrolledList<T, N, Alloc> & UnrolledList<T, N, Alloc>::push(args&&... a) {
+    emplace_front(std::forward<args>(a)...);
+    return *this;
+}
+
+template<typename T, size_t N, typename Alloc>
+template<typename... args>
+T & UnrolledList<T, N, Alloc>::emplace_front(args&&... a) {
+    
+    if (head == nullptr or head->count == N) {
+        link_block_after(nullptr, create_block_with(std::forward<args>(a)...));
+        ++len;
+        return head->items()[0];
+    }
+    
+    return emplace_at(head, 0, std::forward<args>(a)...);
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> &
+UnrolledList<T, N, Alloc>::insert(const size_t index, const T & item) {
+    emplace(index, item);
+    return *this;
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> &
+UnrolledList<T, N, Alloc>::insert(const size_t index, T && item) {
+    emplace(index, std::move(item));
+    return *this;
+}
+
+template<typename T, size_t N, typename Alloc>
+template<typename... args>
+requires std::constructible_from<T, args&&...>
+UnrolledList<T, N, Alloc> &
+UnrolledList<T, N, Alloc>::insert(const size_t index, args&&... a) {
+    emplace(index, std::forward<args>(a)...);
+    return *this;
+}
+
+/* Same semantics as List<T>::insert, the last index appends */
+
+template<typename T, size_t N, typename Alloc>
+template<typename... args>
+T & UnrolledList<T, N, Alloc>::emplace(const size_t index, args&&... a) {
+    
+    checkIndexRange(index);
+    if (index == len - 1) {
+        return emplace_back(std::forward<args>(a)...);
+    }
+    
+    const auto [block, offset] = locate(index);
+    return emplace_at(block, offset, std::forward<args>(a)...);
+    
+}
+
+/* Item extraction */
+
+template<typename T, size_t N, typename Alloc>
+T UnrolledList<T, N, Alloc>::pop_front() {
+    
+    if (head == nullptr) {
+        throw std::runtime_error("Calling UnrolledList<T>::pop_front() on an "
+                                 "empty UnrolledList");
+    }
+    
+    return remove_at(head, 0);
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+T UnrolledList<T, N, Alloc>::pop_back() {
+    
+    if (back == nullptr) {
+        throw std::runtime_error("Calling UnrolledList<T>::pop_back() on an "
+                                 "empty UnrolledList");
+    }
+    
+    return remove_at(back, back->count - 1);
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+T UnrolledList<T, N, Alloc>::remove(const size_t index) {
+    
+    checkIndexRange(index);
+    const auto [block, offset] = locate(index);
+    return remove_at(block, offset);
+    
+}
+
+/* List concatenation */
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc>
+UnrolledList<T, N, Alloc>::concatenate(const UnrolledList<T, N, Alloc> & l) const {
+    UnrolledList<T, N, Alloc> copy(*this);
+    copy += l;
+    return copy;
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc>
+UnrolledList<T, N, Alloc>::operator+(const UnrolledList<T, N, Alloc> & l) const {
+    return concatenate(l);
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc>
+UnrolledList<T, N, Alloc>::concatenate(UnrolledList<T, N, Alloc> && l) const {
+    UnrolledList<T, N, Alloc> copy(*this);
+    copy += std::move(l);
+    return copy;
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc>
+UnrolledList<T, N, Alloc>::operator+(UnrolledList<T, N, Alloc> && l) const {
+    return concatenate(std::move(l));
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> &
+UnrolledList<T, N, Alloc>::append(const UnrolledList<T, N, Alloc> & l) {
+    
+    if (l.len == 0) {
+        return *this;
+    }
+    
+    /* Copied before linking, as in List::append() */
+    
+    block_ptr last;
+    block_ptr first = copy_chain(l.head, last);
+    
+    first->prev = back;
+    if (back) {
+        back->next = first;
+    } else {
+        head = first;
+    }
+    back = last;
+    len += l.len;
+    
+    return *this;
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> &
+UnrolledList<T, N, Alloc>::operator+=(const UnrolledList<T, N, Alloc> & l) {
+    return append(l);
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> &
+UnrolledList<T, N, Alloc>::append(UnrolledList<T, N, Alloc> && l) {
+    
+    if (&l == this or l.len == 0) {
+        return *this;
+    }
+    
+    if (not shares_allocator(l)) {
+        for (T & item : l) {
+            push_back(std::move(item));
+        }
+        l.clear();
+        return *this;
+    }
+    
+    l.head->prev = back;
+    if (back) {
+        back->next = l.head;
+    } else {
+        head = l.head;
+    }
+    back = l.back;
+    len += l.len;
+    
+    l.head = nullptr;
+    l.back = nullptr;
+    l.len = 0;
+    
+    return *this;
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> &
+UnrolledList<T, N, Alloc>::operator+=(UnrolledList<T, N, Alloc> && l) {
+    return append(std::move(l));
+}
+
+/* Assignment */
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> &
+UnrolledList<T, N, Alloc>::assign(const UnrolledList<T, N, Alloc> & l) {
+    
+    if (&l == this) {
+        return *this;
+    }
+    
+    if constexpr (block_traits::propagate_on_container_copy_assignment::value) {
+        if (not shares_allocator(l)) {
+            UnrolledList<T, N, Alloc> copy{allocator_type(l.alloc)};
+            copy.append(l);
+            clear();
+            alloc = l.alloc;
+            steal(copy);
+            return *this;
+        }
+        alloc = l.alloc;
+    }
+    
+    block_ptr last = nullptr;
+    block_ptr first = copy_chain(l.head, last);
+    clear();
+    head = first;
+    back = last;
+    len = l.len;
+    return *this;
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> &
+UnrolledList<T, N, Alloc>::operator=(const UnrolledList<T, N, Alloc> & l) {
+    return assign(l);
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> &
+UnrolledList<T, N, Alloc>::assign(UnrolledList<T, N, Alloc> && l)
+    noexcept(block_traits::propagate_on_container_move_assignment::value or
+             block_traits::is_always_equal::value) {
+    
+    if (&l == this) {
+        return *this;
+    }
+    
+    clear();
+    if constexpr (block_traits::propagate_on_container_move_assignment::value) {
+        alloc = l.alloc;
+    } else if (not shares_allocator(l)) {
+        for (T & item : l) {
+            push_back(std::move(item));
+        }
+        l.clear();
+        return *this;
+    }
+    steal(l);
+    return *this;
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> &
+UnrolledList<T, N, Alloc>::operator=(UnrolledList<T, N, Alloc> && l)
+    noexcept(block_traits::propagate_on_container_move_assignment::value or
+             block_traits::is_always_equal::value) {
+    return assign(std::move(l));
+}
+
+template<typename T, size_t N, typename Alloc>
+void UnrolledList<T, N, Alloc>::swap(UnrolledList<T, N, Alloc> & l) noexcept {
+    
+    if constexpr (block_traits::propagate_on_container_swap::value) {
+        std::swap(alloc, l.alloc);
+    }
+    std::swap(head, l.head);
+    std::swap(back, l.back);
+    std::swap(len, l.len);
+    
+}
+
+/* Utility functions */
+
+template<typename T, size_t N, typename Alloc>
+size_t UnrolledList<T, N, Alloc>::size() const {
+    return len;
+}
+
+template<typename T, size_t N, typename Alloc>
+template<typename Fun, typename U>
+requires std::invocable<Fun &, const T &>
+UnrolledList<U, unrolled_block_capacity<U>,
+             typename std::allocator_traits<Alloc>::template rebind_alloc<U>>
+UnrolledList<T, N, Alloc>::map(Fun fun) const {
+    
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<U>
+        result_allocator;
+    UnrolledList<U, unrolled_block_capacity<U>, result_allocator>
+        l((result_allocator(alloc)));
+    
+    for (block_ptr block = head; block != nullptr; block = block->next) {
+        const T * items = block->items();
+        for (size_t i = 0; i < block->count; ++i) {
+            l.push_back(std::invoke(fun, items[i]));
+        }
+    }
+    
+    return l;
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+template<typename Acc, typename Fun>
+requires std::invocable<Fun &, Acc &, const T &>
+Acc UnrolledList<T, N, Alloc>::fold(Fun fun, Acc initVal) const {
+    
+    for (block_ptr block = head; block != nullptr; block = block->next) {
+        const T * items = block->items();
+        for (size_t i = 0; i < block->count; ++i) {
+            std::invoke(fun, initVal, items[i]);
+        }
+    }
+    
+    return initVal;
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+template<typename Fun>
+requires std::predicate<Fun &, const T &>
+UnrolledList<T, N, Alloc> UnrolledList<T, N, Alloc>::filter(Fun fun) const {
+    
+    UnrolledList<T, N, Alloc> l(get_allocator());
+    
+    for (block_ptr block = head; block != nullptr; block = block->next) {
+        const T * items = block->items();
+        for (size_t i = 0; i < block->count; ++i) {
+            if (std::invoke(fun, items[i])) {
+                l.push_back(items[i]);
+            }
+        }
+    }
+    
+    return l;
+    
+}
+
+/* Compacts each block in place, then merges it into the previous one */
+/* when both fit, as remove() does                                    */
+
+template<typename T, size_t N, typename Alloc>
+template<typename Fun>
+requires std::predicate<Fun &, const T &>
+size_t UnrolledList<T, N, Alloc>::remove_if(Fun fun) {
+    
+    size_t removed = 0;
+    block_ptr block = head;
+    
+    while (block != nullptr) {
+        
+        block_ptr next = block->next;
+        T * items = block->items();
+        
+        /* Items in [kept, i) have been destroyed or moved down */
+        size_t kept = 0;
+        size_t i = 0;
+        
+        const auto close_gap = [&]() {
+            for (size_t j = i; j < block->count; ++j) {
+                std::construct_at(items + kept + j - i, std::move(items[j]));
+                std::destroy_at(items + j);
+            }
+            removed += i - kept;
+            len -= i - kept;
+            block->count -= i - kept;
+        };
+        
+        try {
+            for (; i < block->count; ++i) {
+                if (std::invoke(fun, std::as_const(items[i]))) {
+                    std::destroy_at(items + i);
+                } else {
+                    if (kept != i) {
+                        std::construct_at(items + kept, std::move(items[i]));
+                        std::destroy_at(items + i);
+                    }
+                    ++kept;
+                }
+            }
+        } catch (...) {
+            close_gap();
+            if (block->count == 0) {
+                unlink_block(block);
+                destroy_block(block);
+            }
+            throw;
+        }
+        close_gap();
+        
+        if (block->count == 0) {
+            unlink_block(block);
+            destroy_block(block);
+        } else if (block->prev) {
+            merge_next(block->prev);
+        }
+        
+        block = next;
+        
+    }
+    
+    return removed;
+    
+}
+
+template<typename T, size_t N, typename Alloc>
+template<typename Fun>
+requires std::predicate<Fun &, const T &>
+size_t UnrolledList<T, N, Alloc>::retain(Fun fun) {
+    return remove_if([&fun](const T & item) {
+        return not std::invoke(fun, item);
+    });
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc> & UnrolledList<T, N, Alloc>::clear() {
+    
+    if constexpr (not std::is_trivially_destructible_v<T> or
+                  not allocator_releases_in_bulk<block_allocator>::value) {
+        destroy_chain(head);
+    }
+    
+    head = nullptr;
+    back = nullptr;
+    len = 0;
+    
+    return *this;
+    
+}
+
+/* Constructors */
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc>::UnrolledList() { }
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc>::UnrolledList(const Alloc & allocator)
+    : alloc(allocator) { }
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc>::UnrolledList(const UnrolledList<T, N, Alloc> & orig)
+    : alloc(block_traits::select_on_container_copy_construction(orig.alloc)) {
+    append(orig);
+}
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc>::UnrolledList(UnrolledList<T, N, Alloc> && orig) noexcept
+    : alloc(orig.alloc) {
+    steal(orig);
+}
+
+/* Destructor */
+
+template<typename T, size_t N, typename Alloc>
+UnrolledList<T, N, Alloc>::~UnrolledList() {
+    clear();
+}
+
+/* Swap */
+
+template<typename T, size_t N, typename Alloc>
+void swap(UnrolledList<T, N, Alloc> & lhs, UnrolledList<T, N, Alloc> & rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+#endif /* unrolled_list_hpp */